@@ -0,0 +1,133 @@
+/**
+ * @file LCD_BarGraph.cpp
+ * @author Keith Standiford
+ * @brief Bar graph and level meter widget for the Fast LCD I2C driver
+ * @version 1.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2022 Keith Standiford. All rights reserved. 
+ * 
+ */
+
+#ifdef ARDUINO
+#include "LCD_BarGraph.h"
+#else
+#include <LCD_BarGraph.hpp>
+#endif
+
+
+LCD_BarGraph::LCD_BarGraph(LCD_I2C &lcd, byte line, byte position, byte length,
+        Orientation orientation, byte first_glyph) :
+    _lcd(lcd), _line(line), _position(position), _length(length),
+    _orientation(orientation), _firstGlyph(first_glyph)
+{
+    byte count = _orientation == HORIZONTAL ? HORIZONTAL_GLYPHS : VERTICAL_GLYPHS;
+    if(_firstGlyph + count > LCD_I2C::CUSTOM_CHARS)    // don't run past the last custom character
+        _firstGlyph = LCD_I2C::CUSTOM_CHARS - count;
+
+    // check against limits for the display
+    if(_line >= _lcd.rows()) _line = _lcd.rows()-1;
+    if(_position >= _lcd.columns()) _position = _lcd.columns()-1;
+    if(_orientation == HORIZONTAL) {
+        if(_position + _length > _lcd.columns()) _length = _lcd.columns() - _position;
+    } else {
+        if(_line + _length > _lcd.rows()) _length = _lcd.rows() - _line;
+    }
+}
+
+void LCD_BarGraph::loadGlyphs(LCD_I2C &lcd, Orientation orientation, byte first_glyph)
+{
+    byte glyph[LCD_I2C::CUSTOM_SYMBOL_SIZE];
+    byte count = orientation == HORIZONTAL ? HORIZONTAL_GLYPHS : VERTICAL_GLYPHS;
+    if(first_glyph + count > LCD_I2C::CUSTOM_CHARS)
+        first_glyph = LCD_I2C::CUSTOM_CHARS - count;
+
+    for(byte k = 1; k <= count; k++) {     // glyph k has k dot columns (or rows) filled
+        for(byte row = 0; row < LCD_I2C::CUSTOM_SYMBOL_SIZE; row++) {
+            if(orientation == HORIZONTAL)
+                glyph[row] = (0x1f << (5 - k)) & 0x1f;      // filled from the left
+            else
+                glyph[row] = row >= LCD_I2C::CUSTOM_SYMBOL_SIZE - k ? 0x1f : 0;  // from the bottom
+        }
+        lcd.updateChar(first_glyph + k - 1, glyph, true);   // only sends what changed
+    }
+    lcd.show();
+}
+
+LCD_BarGraph::byte LCD_BarGraph::cell(uint16_t level, byte i) const
+{
+    byte steps = _orientation == HORIZONTAL ? 5 : 8;
+    uint16_t start = i * steps;
+
+    if(level <= start) return EMPTY;
+    if(level >= start + steps) return FULL_BLOCK;
+    return _firstGlyph + (level - start) - 1;
+}
+
+void LCD_BarGraph::drawCells(uint16_t level, byte first, byte last)
+{
+    if(_orientation == HORIZONTAL) {
+        // The cells are next to each other, so one address command will do
+        _lcd.setAddress(_line, _position + first, true);
+        for(byte i = first; i <= last; i++)
+            _lcd.writeChar(cell(level, i), true);
+    } else {
+        // Each cell is on a different line, and cell 0 is at the bottom
+        for(byte i = first; i <= last; i++) {
+            _lcd.setAddress(_line + _length - 1 - i, _position, true);
+            _lcd.writeChar(cell(level, i), true);
+        }
+    }
+}
+
+void LCD_BarGraph::setLevel(uint16_t level, bool Enable_Buffering)
+{
+    if(level > resolution()) level = resolution();
+
+    if(!_drawn) {
+        _level = level;
+        redraw(Enable_Buffering);
+        return;
+    }
+
+    // Only the cells between the old and new edges of the bar can change.
+    // The cells in between go from full to empty or back, but the edge cells may not change.
+    byte steps = _orientation == HORIZONTAL ? 5 : 8;
+    uint16_t low = level < _level ? level : _level;
+    uint16_t high = level < _level ? _level : level;
+    int first = low / steps;
+    int last = (high + steps - 1) / steps - 1;
+    if(last >= _length) last = _length - 1;
+
+    while(first <= last && cell(level, first) == cell(_level, first)) first++;
+    while(last >= first && cell(level, last) == cell(_level, last)) last--;
+    if(first <= last) {
+        if(_orientation == HORIZONTAL) {
+            drawCells(level, first, last);
+        } else {
+            for(int i = first; i <= last; i++)      // skip unchanged cells individually
+                if(cell(level, i) != cell(_level, i)) drawCells(level, i, i);
+        }
+    }
+    _level = level;
+    if(!Enable_Buffering) _lcd.show();
+}
+
+void LCD_BarGraph::setValue(int32_t value, int32_t min, int32_t max, bool Enable_Buffering)
+{
+    if(max <= min || value <= min) {
+        setLevel(0, Enable_Buffering);
+        return;
+    }
+    if(value > max) value = max;
+    // round to the nearest step
+    int64_t range = (int64_t) max - min;
+    setLevel((uint16_t) ((((int64_t) value - min) * resolution() + range / 2) / range), Enable_Buffering);
+}
+
+void LCD_BarGraph::redraw(bool Enable_Buffering)
+{
+    if(_length) drawCells(_level, 0, _length - 1);
+    _drawn = true;
+    if(!Enable_Buffering) _lcd.show();
+}
@@ -0,0 +1,230 @@
+/**
+ * @file LCD_BigDigits.cpp
+ * @author Keith Standiford
+ * @brief Large digit readouts for the Fast LCD I2C driver
+ * @version 1.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2022 Keith Standiford. All rights reserved. 
+ * 
+ */
+
+#ifdef ARDUINO
+#include "LCD_BigDigits.h"
+#else
+#include <LCD_BigDigits.hpp>
+#endif
+
+/*
+ * The font tables. Each symbol (0-9, blank, minus) is a block of character codes, one per cell.
+ * Codes 0-7 are the font's custom characters (offset by the first glyph), anything
+ * else is a character from the display ROM: 0x20 is blank, 0xFF is a solid block.
+ */
+static constexpr int SYMBOLS = 12;
+static constexpr int BLANK = 10;
+static constexpr int MINUS = 11;
+static constexpr int MAX_WIDTH = 40;    // a line of the readout fits in a display RAM line
+
+// 2x2: thin strokes. Each cell has an outside vertical and bars at its top and/or bottom
+static const LCD_BigDigits::byte glyphs_2x2[][LCD_I2C::CUSTOM_SYMBOL_SIZE] = {
+    {0x1f, 0x1f, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18},
+    {0x1f, 0x1f, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x1f},
+    {0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x1f, 0x1f},
+    {0x1f, 0x1f, 0x18, 0x18, 0x18, 0x18, 0x1f, 0x1f},
+    {0x1f, 0x1f, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03},
+    {0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03},
+    {0x1f, 0x1f, 0x03, 0x03, 0x03, 0x03, 0x1f, 0x1f},
+    {0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x1f, 0x1f},
+};
+static const LCD_BigDigits::byte cells_2x2[SYMBOLS][2][2] = {
+    {{0, 4}, {2, 7}},
+    {{0x20, 5}, {0x20, 5}},
+    {{1, 6}, {3, 1}},
+    {{1, 6}, {1, 6}},
+    {{2, 7}, {0x20, 5}},
+    {{3, 1}, {1, 6}},
+    {{3, 1}, {3, 6}},
+    {{0, 4}, {0x20, 5}},
+    {{3, 6}, {3, 6}},
+    {{3, 6}, {1, 6}},
+    {{0x20, 0x20}, {0x20, 0x20}},
+    {{0x5F, 0x5F}, {0x20, 0x20}},
+};
+
+// 3x2: solid strokes with rounded corners
+static const LCD_BigDigits::byte glyphs_3x2[][LCD_I2C::CUSTOM_SYMBOL_SIZE] = {
+    {0x07, 0x0f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f},
+    {0x1f, 0x1f, 0x1f, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x1c, 0x1e, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f},
+    {0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x0f, 0x07},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x1f, 0x1f},
+    {0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1e, 0x1c},
+    {0x1f, 0x1f, 0x1f, 0x00, 0x00, 0x00, 0x1f, 0x1f},
+    {0x1f, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x1f, 0x1f},
+};
+static const LCD_BigDigits::byte cells_3x2[SYMBOLS][2][3] = {
+    {{0, 1, 2}, {3, 4, 5}},
+    {{1, 2, 0x20}, {4, 0xFF, 4}},
+    {{6, 6, 2}, {3, 7, 7}},
+    {{6, 6, 2}, {7, 7, 5}},
+    {{3, 4, 0xFF}, {0x20, 0x20, 0xFF}},
+    {{0xFF, 6, 6}, {7, 7, 5}},
+    {{0, 6, 6}, {3, 7, 5}},
+    {{1, 1, 2}, {0x20, 0x20, 0xFF}},
+    {{0, 6, 2}, {3, 7, 5}},
+    {{0, 6, 2}, {7, 7, 5}},
+    {{0x20, 0x20, 0x20}, {0x20, 0x20, 0x20}},
+    {{4, 4, 4}, {0x20, 0x20, 0x20}},
+};
+
+// 3x4: a 3x8 dot font drawn with upper and lower half blocks
+static const LCD_BigDigits::byte glyphs_3x4[][LCD_I2C::CUSTOM_SYMBOL_SIZE] = {
+    {0x1f, 0x1f, 0x1f, 0x1f, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x1f, 0x1f, 0x1f, 0x1f},
+};
+static const LCD_BigDigits::byte cells_3x4[SYMBOLS][4][3] = {
+    {{0xFF, 0, 0xFF}, {0xFF, 0x20, 0xFF}, {0xFF, 0x20, 0xFF}, {0xFF, 1, 0xFF}},
+    {{1, 0xFF, 0x20}, {0x20, 0xFF, 0x20}, {0x20, 0xFF, 0x20}, {1, 0xFF, 1}},
+    {{0, 0, 0xFF}, {1, 1, 0xFF}, {0xFF, 0x20, 0x20}, {0xFF, 1, 1}},
+    {{0, 0, 0xFF}, {0x20, 1, 0xFF}, {0x20, 0x20, 0xFF}, {1, 1, 0xFF}},
+    {{0xFF, 0x20, 0xFF}, {0xFF, 1, 0xFF}, {0x20, 0x20, 0xFF}, {0x20, 0x20, 0xFF}},
+    {{0xFF, 0, 0}, {0xFF, 1, 1}, {0x20, 0x20, 0xFF}, {1, 1, 0xFF}},
+    {{0xFF, 0, 0}, {0xFF, 1, 1}, {0xFF, 0x20, 0xFF}, {0xFF, 1, 0xFF}},
+    {{0, 0, 0xFF}, {0x20, 0x20, 0xFF}, {0x20, 0xFF, 0x20}, {0x20, 0xFF, 0x20}},
+    {{0xFF, 0, 0xFF}, {0xFF, 1, 0xFF}, {0xFF, 0x20, 0xFF}, {0xFF, 1, 0xFF}},
+    {{0xFF, 0, 0xFF}, {0xFF, 1, 0xFF}, {0x20, 0x20, 0xFF}, {1, 1, 0xFF}},
+    {{0x20, 0x20, 0x20}, {0x20, 0x20, 0x20}, {0x20, 0x20, 0x20}, {0x20, 0x20, 0x20}},
+    {{0x20, 0x20, 0x20}, {1, 1, 1}, {0x20, 0x20, 0x20}, {0x20, 0x20, 0x20}},
+};
+
+struct FontInfo {
+    LCD_BigDigits::byte width;
+    LCD_BigDigits::byte height;
+    LCD_BigDigits::byte glyphs;
+    const LCD_BigDigits::byte (*glyph_map)[LCD_I2C::CUSTOM_SYMBOL_SIZE];
+    const LCD_BigDigits::byte *cells;      // [SYMBOLS][height][width]
+};
+
+static const FontInfo fonts[] = {
+    {2, 2, 8, glyphs_2x2, &cells_2x2[0][0][0]},
+    {3, 2, 8, glyphs_3x2, &cells_3x2[0][0][0]},
+    {3, 4, 2, glyphs_3x4, &cells_3x4[0][0][0]},
+};
+
+static int symbol(char c)
+{
+    if(c >= '0' && c <= '9') return c - '0';
+    if(c == '-') return MINUS;
+    return BLANK;
+}
+
+
+LCD_BigDigits::LCD_BigDigits(LCD_I2C &lcd, byte line, byte position, byte digits, Font font,
+        byte spacing, byte first_glyph) :
+    _lcd(lcd), _line(line), _position(position), _digits(digits), _font(font),
+    _spacing(spacing), _firstGlyph(first_glyph)
+{
+    const FontInfo &f = fonts[_font];
+    _width = f.width;
+    _height = f.height;
+    if(_firstGlyph + f.glyphs > LCD_I2C::CUSTOM_CHARS) 
+        _firstGlyph = LCD_I2C::CUSTOM_CHARS - f.glyphs;
+    
+    // check against limits for the display
+    if(_line + _height > _lcd.rows()) _line = _lcd.rows() > _height ? _lcd.rows() - _height : 0;
+    if(_digits > MAX_DIGITS) _digits = MAX_DIGITS;
+    if(_height > _lcd.rows()) _digits = 0;     // the font is too tall to draw at all
+    while(_digits && _position + _digits * (_width + _spacing) - _spacing > _lcd.columns()) _digits--;
+    memset(_shown, ' ', sizeof(_shown));
+}
+
+LCD_BigDigits::byte LCD_BigDigits::glyphCount(Font font)
+{
+    return fonts[font].glyphs;
+}
+
+void LCD_BigDigits::loadGlyphs(LCD_I2C &lcd, Font font, byte first_glyph)
+{
+    const FontInfo &f = fonts[font];
+
+    if(first_glyph + f.glyphs > LCD_I2C::CUSTOM_CHARS) 
+        first_glyph = LCD_I2C::CUSTOM_CHARS - f.glyphs;
+    for(byte i = 0; i < f.glyphs; i++)
+        lcd.updateChar(first_glyph + i, f.glyph_map[i], true);  // only sends what changed
+    lcd.show();
+}
+
+void LCD_BigDigits::renderLine(const char digits[], byte row, byte cells[]) const
+{
+    const FontInfo &f = fonts[_font];
+    byte n = 0;
+
+    for(byte d = 0; d < _digits; d++) {
+        const byte *code = f.cells + (symbol(digits[d]) * _height + row) * _width;
+        for(byte col = 0; col < _width; col++, code++)
+            cells[n++] = *code < LCD_I2C::CUSTOM_CHARS ? *code + _firstGlyph : *code;
+        if(d + 1 < _digits)
+            for(byte col = 0; col < _spacing; col++) cells[n++] = ' ';
+    }
+}
+
+void LCD_BigDigits::update(const char digits[], bool Enable_Buffering)
+{
+    byte cells[MAX_WIDTH];
+    byte shown[sizeof(cells)];
+    byte length = _digits * (_width + _spacing) - _spacing;
+
+    if(_digits == 0) return;
+    for(byte row = 0; row < _height; row++) {
+        renderLine(digits, row, cells);
+        if(_drawn) {
+            renderLine(_shown, row, shown);
+        } else {
+            for(byte i = 0; i < length; i++) shown[i] = ~cells[i];   // force every cell
+        }
+        _lcd.writeChanges(_line + row, _position, cells, shown, length, true);
+    }
+    memcpy(_shown, digits, _digits);
+    _drawn = true;
+    if(!Enable_Buffering) _lcd.show();
+}
+
+void LCD_BigDigits::setText(const char text[], bool Enable_Buffering)
+{
+    char digits[MAX_DIGITS];
+    byte i = 0;
+
+    if(text != NULL)
+        for(; i < _digits && text[i]; i++) digits[i] = symbol(text[i]) == BLANK ? ' ' : text[i];
+    for(; i < _digits; i++) digits[i] = ' ';
+    update(digits, Enable_Buffering);
+}
+
+void LCD_BigDigits::setNumber(int32_t value, bool Enable_Buffering)
+{
+    char digits[MAX_DIGITS];
+    uint32_t magnitude = value < 0 ? 0u - (uint32_t) value : (uint32_t) value;
+    int i = _digits;
+
+    if(_digits == 0) return;                    // no room for even one digit
+    do {                                        // fill from the right
+        digits[--i] = '0' + magnitude % 10;
+        magnitude /= 10;
+    } while(magnitude && i > 0);
+    if(value < 0 && i > 0) digits[--i] = '-';
+    if(magnitude || (value < 0 && digits[i] != '-')) {   // it didn't fit
+        memset(digits, '-', _digits);
+        i = 0;
+    }
+    while(i > 0) digits[--i] = ' ';
+    update(digits, Enable_Buffering);
+}
+
+void LCD_BigDigits::redraw(bool Enable_Buffering)
+{
+    char digits[MAX_DIGITS];
+
+    memcpy(digits, _shown, sizeof(digits));
+    _drawn = false;
+    update(digits, Enable_Buffering);
+}
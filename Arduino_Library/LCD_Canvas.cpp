@@ -0,0 +1,138 @@
+/**
+ * @file LCD_Canvas.cpp
+ * @author Keith Standiford
+ * @brief A small pixel graphics window for the Fast LCD I2C driver
+ * @version 1.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2022 Keith Standiford. All rights reserved. 
+ * 
+ */
+
+#include <stdlib.h>
+#ifdef ARDUINO
+#include "LCD_Canvas.h"
+#else
+#include <LCD_Canvas.hpp>
+#endif
+
+
+LCD_Canvas::LCD_Canvas(LCD_I2C &lcd, byte line, byte position, byte columns, byte rows,
+        byte first_glyph) :
+    _lcd(lcd), _line(line), _position(position), _columns(columns), _rows(rows),
+    _firstGlyph(first_glyph)
+{
+    // check against limits for the custom characters and the display
+    if(_firstGlyph >= MAX_TILES) _firstGlyph = MAX_TILES - 1;
+    if(_columns < 1) _columns = 1;
+    if(_rows < 1) _rows = 1;
+    if(_line >= _lcd.rows()) _line = _lcd.rows() - 1;
+    if(_position >= _lcd.columns()) _position = _lcd.columns() - 1;
+    if(_line + _rows > _lcd.rows()) _rows = _lcd.rows() - _line;
+    if(_position + _columns > _lcd.columns()) _columns = _lcd.columns() - _position;
+    if(_columns > MAX_TILES - _firstGlyph) _columns = MAX_TILES - _firstGlyph;
+    while(_columns * _rows > MAX_TILES - _firstGlyph) _rows--;
+    clear();
+}
+
+void LCD_Canvas::clear(void)
+{
+    memset(_bits, 0, sizeof(_bits));
+    _lastY = -1;
+    _dirty = true;
+}
+
+void LCD_Canvas::setPixel(int x, int y, bool on)
+{
+    if(x < 0 || y < 0 || x >= width() || y >= height()) return;
+    byte &row = _bits[(y / TILE_HEIGHT) * _columns + x / TILE_WIDTH][y % TILE_HEIGHT];
+    byte bit = 0x10 >> (x % TILE_WIDTH);     // the msb is the left most dot
+    if(on) row |= bit;
+    else row &= ~bit;
+    _dirty = true;
+}
+
+bool LCD_Canvas::getPixel(int x, int y) const
+{
+    if(x < 0 || y < 0 || x >= width() || y >= height()) return false;
+    return _bits[(y / TILE_HEIGHT) * _columns + x / TILE_WIDTH][y % TILE_HEIGHT] & (0x10 >> (x % TILE_WIDTH));
+}
+
+void LCD_Canvas::line(int x0, int y0, int x1, int y1, bool on)
+{
+    // Bresenham's line algorithm
+    int dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+    int dy = -abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+    int err = dx + dy;
+
+    for(;;) {
+        setPixel(x0, y0, on);
+        if(x0 == x1 && y0 == y1) break;
+        int e2 = 2 * err;
+        if(e2 >= dy) { err += dy; x0 += sx; }
+        if(e2 <= dx) { err += dx; y0 += sy; }
+    }
+}
+
+int LCD_Canvas::scale(int16_t value, int16_t min, int16_t max) const
+{
+    if(max <= min || value <= min) return height() - 1;
+    if(value >= max) return 0;
+    return height() - 1 - ((int32_t) (value - min) * (height() - 1) + (max - min) / 2) / (max - min);
+}
+
+void LCD_Canvas::plot(const int16_t values[], int count, int16_t min, int16_t max)
+{
+    if(values == NULL) return;
+    if(count > width()) count = width();
+    for(int x = 0; x < count; x++) {
+        int y = scale(values[x], min, max);
+        if(x == 0) setPixel(x, y);
+        else line(x - 1, scale(values[x-1], min, max), x, y);
+    }
+}
+
+void LCD_Canvas::scrollLeft(int pixels)
+{
+    if(pixels <= 0) return;
+    for(int tile_row = 0; tile_row < _rows; tile_row++) {
+        byte (*tiles)[TILE_HEIGHT] = &_bits[tile_row * _columns];
+        for(int y = 0; y < TILE_HEIGHT; y++) {
+            // gather one pixel row across the tiles, msb on the left
+            uint64_t bits = 0;
+            for(int t = 0; t < _columns; t++) bits = bits << TILE_WIDTH | tiles[t][y];
+            bits = pixels < width() ? bits << pixels : 0;
+            for(int t = _columns - 1; t >= 0; t--, bits >>= TILE_WIDTH) tiles[t][y] = bits & 0x1f;
+        }
+    }
+    _dirty = true;
+}
+
+void LCD_Canvas::push(int16_t value, int16_t min, int16_t max)
+{
+    int x = width() - 1;
+    int y = scale(value, min, max);
+
+    scrollLeft(1);
+    if(_lastY < 0) setPixel(x, y);
+    else line(x - 1, _lastY, x, y);
+    _lastY = y;
+}
+
+int LCD_Canvas::commit(bool Enable_Buffering)
+{
+    int sent = 0;
+
+    if(_dirty) sent = _lcd.updateChars(_firstGlyph, _columns * _rows, _bits, true);
+    _dirty = false;
+    if(!_placed) {
+        for(byte row = 0; row < _rows; row++) {
+            _lcd.setAddress(_line + row, _position, true);
+            for(byte col = 0; col < _columns; col++)
+                _lcd.writeChar(_firstGlyph + row * _columns + col, true);
+        }
+        _placed = true;
+    }
+    if(!Enable_Buffering) _lcd.show();
+    return sent;
+}
@@ -20,9 +20,18 @@
 #include <hardware/gpio.h>
 #include <hardware/i2c.h>
 #include <pico/binary_info.h>
+#include <hardware/timer.h>
 #include <string.h>
 #include <cstdint>
 #include <LCD_I2C.hpp>
+#if LCD_I2C_BUFFER_POOL
+#include <LCD_BufferPool.hpp>
+#endif
+#endif
+
+#if LCD_I2C_LOCKING == LCD_I2C_LOCK_SPINLOCK
+// Interrupts are off while the spin lock is held, so we must not sleep
+#define sleep_us busy_wait_us
 #endif
 
 
@@ -41,12 +50,145 @@ LCD_I2C::LCD_I2C(uint8_t lcd_addr, uint8_t lcd_cols, uint8_t lcd_rows, uint8_t c
 
 // Pi Pico version
 
-LCD_I2C::LCD_I2C(byte address, byte columns, byte rows, i2c_inst * I2C) :
+LCD_I2C::LCD_I2C(byte address, byte columns, byte rows, i2c_inst * I2C, bool Initialize) :
     _Addr(address),_rows(rows),_cols(columns), _backlight(LCD_NOBACKLIGHT), I2C_instance(I2C)
 {        
     if(rows > MAX_LINES) _rows = MAX_LINES; // check against limits
     if(columns > MAX_CHARS) _cols = MAX_CHARS;
-    init();
+    #if LCD_I2C_LOCKING == LCD_I2C_LOCK_SPINLOCK
+    _spinLockNum = spin_lock_claim_unused(true);
+    _spinLock = spin_lock_instance(_spinLockNum);
+    #elif LCD_I2C_LOCKING == LCD_I2C_LOCK_MUTEX
+    recursive_mutex_init(&_mutex);
+    #endif
+    if(Initialize) init();
+}
+
+LCD_I2C::~LCD_I2C()
+{
+    if(_alarm > 0) cancel_alarm(_alarm);
+    #if LCD_I2C_BUFFER_POOL
+    return_buffer();        // anything still waiting is dropped, but the pool gets its buffer back
+    #endif
+    #if LCD_I2C_LOCKING == LCD_I2C_LOCK_SPINLOCK
+    spin_lock_unclaim(_spinLockNum);
+    #endif
+}
+#endif
+
+// locking
+
+#if LCD_I2C_LOCKING == LCD_I2C_LOCK_SPINLOCK
+void LCD_I2C::lock(void)
+{
+    uint core = get_core_num();
+    if(_lockOwner == core) {    // only we can have set it to our core
+        _lockDepth++;
+        return;
+    }
+    uint32_t saved = spin_lock_blocking(_spinLock);   // also disables interrupts
+    _savedIrq = saved;
+    _lockOwner = core;
+    _lockDepth = 1;
+}
+
+void LCD_I2C::unlock(void)
+{
+    if(--_lockDepth) return;
+    _lockOwner = NO_OWNER;
+    spin_unlock(_spinLock, _savedIrq);
+}
+#elif LCD_I2C_LOCKING == LCD_I2C_LOCK_MUTEX
+void LCD_I2C::lock(void)
+{
+    recursive_mutex_enter_blocking(&_mutex);
+}
+
+void LCD_I2C::unlock(void)
+{
+    recursive_mutex_exit(&_mutex);
+}
+#endif
+
+#if LCD_I2C_BUFFER_POOL
+LCD_BufferPool *LCD_I2C::_pool = nullptr;
+
+void LCD_I2C::setBufferPool(LCD_BufferPool *pool)
+{
+    _pool = pool;
+}
+
+void LCD_I2C::borrow_buffer(void)
+{
+    if(_buffer != _spare || _pool == nullptr) return;
+    byte *buffer = _pool->take();
+    if(buffer != nullptr) {
+        _buffer = buffer;
+        _capacity = BUFFER_LENGTH;
+    }
+}
+
+void LCD_I2C::return_buffer(void)
+{
+    if(_buffer == _spare) return;
+    _pool->give(_buffer);
+    _buffer = _spare;
+    _capacity = SPARE_LENGTH;
+}
+#endif
+
+bool LCD_I2C::try_lock(void)
+{
+    #if LCD_I2C_LOCKING == LCD_I2C_LOCK_MUTEX
+    return recursive_mutex_try_enter(&_mutex, NULL);  // never block an interrupt handler on a mutex
+    #else
+    lock();     // a spin lock is only ever held briefly
+    return true;
+    #endif
+}
+
+#ifndef ARDUINO
+void LCD_I2C::setAutoFlush(uint32_t idle_us, size_t fill_level)
+{
+    Guard guard(*this);
+    _autoFlushUs = idle_us;
+    _autoFlushFill = fill_level;
+    if(_autoFlushUs == 0 && _alarm > 0) {
+        cancel_alarm(_alarm);
+        _alarm = 0;
+    }
+}
+
+int64_t LCD_I2C::auto_flush_alarm(alarm_id_t, void *lcd)
+{
+    return ((LCD_I2C *) lcd)->auto_flush();
+}
+
+int64_t LCD_I2C::auto_flush(void)
+{
+    if(!try_lock()) return -(int64_t) AUTO_FLUSH_RETRY_US;
+    if(_calls) {        // interrupted a call, so try again shortly
+        unlock();
+        return -(int64_t) AUTO_FLUSH_RETRY_US;
+    }
+    uint32_t idle = time_us_32() - _lastWrite;
+    if(_autoFlushUs && idle < _autoFlushUs) {   // written to since, so wait some more
+        unlock();
+        return -(int64_t) (_autoFlushUs - idle);
+    }
+    // Never wait here, since this is an interrupt. A slow command is waited out by trying 
+    // again once it is done, and a lost display is looked for by the next show() instead.
+    if(!_cooperative) {
+        while(backlog() && !holding()) showSome(BUFFER_LENGTH);
+        if(backlog()) {
+            int32_t left = _holdUntil - time_us_32();
+            unlock();
+            return -(int64_t) (left > 0 ? left : 1);
+        }
+    }
+    _alarm = 0;
+    unlock();
+    return 0;
 }
 #endif
 
@@ -55,11 +197,9 @@ LCD_I2C::LCD_I2C(byte address, byte columns, byte rows, i2c_inst * I2C) :
 /* Quick helper function for single byte transfers */
 void LCD_I2C::write_byte(byte val,bool Enable_Buffering )   
 {
-    static byte data;
-
     // We always use the buffer. So make sure it isn't full
-    if(_bufferIn>=BUFFER_LENGTH) show();   // OOPS! It is full, empty it NOW
-    data = val | _backlight;
+    make_room(1);
+    byte data = val | _backlight;
 
 /*   // For Arduino
     #ifdef ARDUINO
@@ -79,16 +219,13 @@ void LCD_I2C::write_byte(byte val,bool Enable_Buffering )
 
 void LCD_I2C::send_byte(byte val, int  mode,bool Enable_Buffering )  
 {
-
-    static byte high;
-    static byte low;
     // We always use the buffer. So make sure it isn't full
     // We may insert 4-5 bytes since we must use nibbles
     // Don't send mode unless it changed
-    if(_bufferIn>=BUFFER_LENGTH-4-(_last_mode==mode?0:1)) show();   // OOPS! It is too full, empty it NOW
+    make_room(_last_mode==mode ? 4 : 5);
 
-    high = val &0xF0u | mode;           // get high 4 bit nibble and mode bits
-    low = ((val & 0xfu) << 4 | mode);   // get low 4 bit nibble and mode bits
+    byte high = val &0xF0u | mode;          // get high 4 bit nibble and mode bits
+    byte low = ((val & 0xfu) << 4 | mode);  // get low 4 bit nibble and mode bits
     if(_last_mode != mode){             // if mode changed, we must output it first
         _last_mode = mode;
         write_byte(mode, true);   // Must set cmmd and R/W bits before enable goes high
@@ -98,20 +235,151 @@ void LCD_I2C::send_byte(byte val, int  mode,bool Enable_Buffering )
     write_byte(low | ENABLE, true);     // Raise enable, set up data bit for low nibble
     write_byte(low & ~ENABLE, true);    // Drop enable to latch low nibble
                                         // This initiates data write or command execution    
+    track(val, mode);
+    end_write(Enable_Buffering);
+}
+
+// The next display RAM address, for two line addressing (0x00-0x27 and 0x40-0x67)
+static inline uint8_t next_address(uint8_t address, bool forward)
+{
+    if(forward) return address == 0x27 ? 0x40 : address == 0x67 ? 0 : address + 1;
+    return address == 0 ? 0x67 : address == 0x40 ? 0x27 : address - 1;
+}
+
+// The index in the copy of the display RAM for an address, or -1 if there is no RAM there
+static inline int ddram_index(uint8_t address)
+{
+    uint8_t offset = address & 0x3f;
+    if(offset >= LCD_I2C::DDRAM_LINE_LENGTH) return -1;
+    return (address & 0x40 ? LCD_I2C::DDRAM_LINE_LENGTH : 0) + offset;
+}
+
+void LCD_I2C::track(byte val, int mode)
+{
+    if(mode == LCD_CHARACTER) {
+        if(_addressCGRAM) return;
+        int index = ddram_index(_address);
+        if(index >= 0) _ddram[index] = val;
+        bool forward = _displaymode & LCD_ENTRYLEFT;
+        _address = next_address(_address, forward);
+        if(_displaymode & LCD_DISPLAYENTRYSHIFT)    // autoscroll moves the display the other way
+            _shift = (_shift + (forward ? 1 : DDRAM_LINE_LENGTH - 1)) % DDRAM_LINE_LENGTH;
+    } else if(val & LCD_SETDDRAMADDR) {
+        _address = val & 0x7f;
+        _addressCGRAM = false;
+    } else if(val & LCD_SETCGRAMADDR) {
+        _addressCGRAM = true;
+    } else if(val == LCD_CLEARDISPLAY || val == LCD_RETURNHOME) {
+        if(val == LCD_CLEARDISPLAY) {
+            memset(_ddram, ' ', sizeof(_ddram));
+            _displaymode |= LCD_ENTRYLEFT;      // the display does this too
+        }
+        _address = 0;
+        _addressCGRAM = false;
+        _shift = 0;
+    } else if((val & 0xf8) == LCD_DISPLAYSHIFT && !_addressCGRAM) {     // cursor move
+        _address = next_address(_address, val & LCD_MOVERIGHT);
+    } else if((val & 0xf8) == (LCD_DISPLAYSHIFT | LCD_DISPLAYMOVE)) {   // display shift
+        _shift = (_shift + (val & LCD_MOVERIGHT ? DDRAM_LINE_LENGTH - 1 : 1)) % DDRAM_LINE_LENGTH;
+    }
+}
+
+void LCD_I2C::track_encoded(const byte wire[], size_t length)
+{
+    // Each character or command is 4 bytes, starting with enable high. Mode bytes come between them.
+    for(size_t i = 0; i + 3 < length; ) {
+        if(!(wire[i] & ENABLE)) {
+            i++;
+            continue;
+        }
+        track((wire[i] & 0xf0) | (wire[i + 2] >> 4), wire[i] & Rs);
+        i += 4;
+    }
+}
+
+void LCD_I2C::end_write(bool Enable_Buffering)
+{
     if(!Enable_Buffering) show();       // if we are not supposed to be buffering, do it now!
+    #ifndef ARDUINO
+    else if(_autoFlushUs && !_cooperative) {    // write-behind, after a whole character or command
+        _lastWrite = time_us_32();
+        if(_autoFlushFill && backlog() >= _autoFlushFill)
+            show();
+        else if(_alarm <= 0)
+            _alarm = add_alarm_in_us(_autoFlushUs, auto_flush_alarm, this, true);
+    }
+    #endif
 }
 
 
 void LCD_I2C::clear(void)
 {
-    send_byte(LCD_CLEARDISPLAY, LCD_COMMAND);
-    sleep_us(2000); // command takes a long time
+    Guard guard(*this);
+
+    // What writing spaces would take instead: the characters which are not blank, the
+    // shift undone whichever way is shorter, and the cursor back home. Each is 4 bytes,
+    // plus a mode byte now and then.
+    size_t bytes = 0;
+    blank_cells(0, DDRAM_LINE_LENGTH, false, bytes);
+    blank_cells(DDRAM_LINE_LENGTH, DDRAM_LINE_LENGTH, false, bytes);
+    byte shift = _shift <= DDRAM_LINE_LENGTH / 2 ? _shift : DDRAM_LINE_LENGTH - _shift;
+    bool home = _address != 0 || _addressCGRAM || bytes > 0;    // writing the spaces moves it
+    bytes += 4 * shift + (home ? 5 : 0);
+    if(_displaymode != (LCD_ENTRYLEFT | LCD_ENTRYMODESET)) bytes += 10;
+
+    if(bytes * _usPerByte16 / 16 >= CLEAR_TIME_US) {
+        uint32_t time = startClear();
+        if(!_cooperative) sleep_us(time); // command takes a long time
+        return;
+    }
+
+    byte mode = _displaymode;
+    if(mode != (LCD_ENTRYLEFT | LCD_ENTRYMODESET)) {
+        _displaymode = LCD_ENTRYLEFT | LCD_ENTRYMODESET;
+        send_byte(_displaymode, LCD_COMMAND, true);
+    }
+    blank_cells(0, DDRAM_LINE_LENGTH, true, bytes);
+    blank_cells(DDRAM_LINE_LENGTH, DDRAM_LINE_LENGTH, true, bytes);
+    bool left = _shift > DDRAM_LINE_LENGTH / 2;
+    for(; shift > 0; shift--)
+        send_byte(LCD_DISPLAYSHIFT | LCD_DISPLAYMOVE | (left ? LCD_MOVELEFT : LCD_MOVERIGHT), LCD_COMMAND, true);
+    if((mode | LCD_ENTRYLEFT) != _displaymode) {   // the clear command sets left to right too
+        _displaymode = mode | LCD_ENTRYLEFT;
+        send_byte(_displaymode, LCD_COMMAND, true);
+    }
+    if(home) send_byte(LCD_SETDDRAMADDR, LCD_COMMAND, true);
+    show();
 }
 
 void LCD_I2C::home(void)
 {
-    send_byte(LCD_RETURNHOME, LCD_COMMAND);
-    sleep_us(2000); // command takes a long time
+    uint32_t time = startHome();
+    if(!_cooperative) sleep_us(time); // command takes a long time
+}
+
+uint32_t LCD_I2C::startClear(void)
+{
+    return start_slow_command(LCD_CLEARDISPLAY);
+}
+
+uint32_t LCD_I2C::startHome(void)
+{
+    return start_slow_command(LCD_RETURNHOME);
+}
+
+uint32_t LCD_I2C::start_slow_command(byte command)
+{
+    Guard guard(*this);
+    if(!_cooperative) {
+        send_byte(command, LCD_COMMAND);
+        return CLEAR_TIME_US;
+    }
+    // In cooperative mode, remember where the command ends so that
+    // nothing after it is sent until the display is ready again
+    while(_holds >= MAX_HOLDS) drain_some();
+    send_byte(command, LCD_COMMAND, true);
+    _holdAt[_holds++] = _bufferIn;
+    return CLEAR_TIME_US;
 }
 
 // go to location on LCD
@@ -122,17 +390,126 @@ void LCD_I2C::setCursor(byte position, byte line, bool Enable_Buffering)
 void LCD_I2C::setCursor(byte line, byte position, bool Enable_Buffering)
 #endif
 {
+    Guard guard(*this);
     if(line >= _rows) line = _rows-1;   // Check against limits for display
     if(position >= _cols) position = _cols-1;
     byte val = row_address_offset[line] + position;
     send_byte(val, LCD_COMMAND, Enable_Buffering);
 }
 
+void LCD_I2C::setAddress(byte line, byte position, bool Enable_Buffering)
+{
+    Guard guard(*this);
+    if(line >= _rows) line = _rows-1;   // Check against limits for display RAM
+    byte limit = DDRAM_LINE_LENGTH - (row_address_offset[line] & 0x3f);
+    if(position >= limit) position = limit-1;
+    send_byte(row_address_offset[line] + position, LCD_COMMAND, Enable_Buffering);
+}
+
+int LCD_I2C::writeChanges(byte line, byte position, const byte data[], byte shown[], byte length,
+        bool Enable_Buffering)
+{
+    Guard guard(*this);
+    int sent = 0;
+    int i = 0;
+
+    while(i < length) {
+        if(data[i] == shown[i]) {   // skip what is already there
+            i++;
+            continue;
+        }
+        // Find the end of this run, bridging single unchanged characters (4 bytes)
+        // which are cheaper than a new address command plus the mode changes (6 bytes)
+        int end = i + 1;
+        while(end < length) {
+            if(data[end] != shown[end]) end++;
+            else if(end + 1 < length && data[end+1] != shown[end+1]) end += 2;
+            else break;
+        }
+        setAddress(line, position + i, true);
+        for(; i < end; i++, sent++) {
+            shown[i] = data[i];
+            send_byte(data[i], LCD_CHARACTER, true);
+        }
+    }
+    if(!Enable_Buffering) show();
+    return sent;
+}
+
+int LCD_I2C::clearRegion(byte line, byte position, byte width, byte height, bool Enable_Buffering)
+{
+    Guard guard(*this);
+    if(line >= _rows) return 0;
+    if(height > _rows - line) height = _rows - line;
+
+    // Anything to do?
+    size_t bytes = 0;
+    int cells = 0;
+    byte first[MAX_LINES], count[MAX_LINES];
+    for(byte r = 0; r < height; r++) {
+        byte offset = row_address_offset[line + r];
+        byte limit = DDRAM_LINE_LENGTH - (offset & 0x3f);
+        first[r] = ddram_index(offset + position);
+        count[r] = position >= limit ? 0 : width > limit - position ? limit - position : width;
+        cells += blank_cells(first[r], count[r], false, bytes);
+    }
+    if(cells == 0) return 0;
+
+    // The blanks are written left to right, and then the mode and cursor are put back
+    byte mode = _displaymode, address = _address;
+    if(mode != (LCD_ENTRYLEFT | LCD_ENTRYMODESET)) {
+        _displaymode = LCD_ENTRYLEFT | LCD_ENTRYMODESET;
+        send_byte(_displaymode, LCD_COMMAND, true);
+    }
+    for(byte r = 0; r < height; r++) blank_cells(first[r], count[r], true, bytes);
+    if(mode != _displaymode) {
+        _displaymode = mode;
+        send_byte(_displaymode, LCD_COMMAND, true);
+    }
+    send_byte(LCD_SETDDRAMADDR | address, LCD_COMMAND, true);
+    if(!Enable_Buffering) show();
+    return cells;
+}
+
+int LCD_I2C::blank_cells(byte first, byte count, bool send, size_t &bytes)
+{
+    const byte *text = &_ddram[first];
+    int cells = 0;
+    byte i = 0;
+
+    while(i < count) {
+        if(text[i] == ' ') {
+            i++;
+            continue;
+        }
+        // As in writeChanges(), a single blank between runs is cheaper to send than a new address
+        byte end = i + 1;
+        while(end < count && (text[end] != ' ' || (end + 1 < count && text[end + 1] != ' '))) end++;
+        bytes += 6 + 4 * (end - i);
+        cells += end - i;
+        if(send) {
+            byte index = first + i;
+            send_byte(LCD_SETDDRAMADDR | (index / DDRAM_LINE_LENGTH * 0x40 + index % DDRAM_LINE_LENGTH),
+                    LCD_COMMAND, true);
+            for(; i < end; i++) send_byte(' ', LCD_CHARACTER, true);
+        }
+        i = end;
+    }
+    return cells;
+}
+
 
 void LCD_I2C::writeString(const char s[], bool Enable_Buffering)
 {
-    byte c, high, low;
+    Guard guard(*this);
+    byte c;
 
+    #if LCD_I2C_TEXT_CACHE_ENTRIES
+    if(s != NULL && write_cached(s)) {
+        end_write(Enable_Buffering);
+        return;
+    }
+    #endif
     if(s!=NULL) {           // Trust but verify!
         while(c=*s++) {                     // for all the characters...
             send_byte(c,LCD_CHARACTER,true);    // let him do the work
@@ -143,11 +520,13 @@ void LCD_I2C::writeString(const char s[], bool Enable_Buffering)
 
 void LCD_I2C::writeChar(byte c, bool Enable_Buffering)
 {
+    Guard guard(*this);
     send_byte(c, LCD_CHARACTER, Enable_Buffering);
 }
 
 size_t LCD_I2C::write(const uint8_t *buffer, size_t size, bool Enable_Buffering)
 {
+    Guard guard(*this);
     if(buffer == NULL)  size=0;     // Don't do anyting if there is no buffer
     size_t i = size;
     while(i--) {
@@ -157,159 +536,593 @@ size_t LCD_I2C::write(const uint8_t *buffer, size_t size, bool Enable_Buffering)
     return size;
 }
 
+void LCD_I2C::writeEncoded(const byte wire[], size_t length, bool Enable_Buffering)
+{
+    Guard guard(*this);
+    if(wire == NULL) length = 0;
+    length &= ~(size_t)3;               // whole characters only
+    if(length) {
+        character_mode();
+        copy_encoded(wire, length);
+        track_encoded(wire, length);
+    }
+    end_write(Enable_Buffering);
+}
+
+void LCD_I2C::character_mode(void)
+{
+    if(_last_mode == LCD_CHARACTER) return;
+    make_room(5);                       // keep the mode byte with the character after it
+    _last_mode = LCD_CHARACTER;         // set the mode bits first, as in send_byte()
+    write_byte(LCD_CHARACTER, true);
+}
+
+void LCD_I2C::sendEncoded(const byte wire[], size_t length, bool Enable_Buffering)
+{
+    Guard guard(*this);
+    if(wire != NULL && length) {
+        copy_encoded(wire, length);
+        track_encoded(wire, length);
+        _last_mode = LCD_CHARACTER;     // the stream ends with a character
+    }
+    end_write(Enable_Buffering);
+}
+
+void LCD_I2C::copy_encoded(const byte wire[], size_t length)
+{
+    while(length) {
+        // Copy whole units only, so the buffer never ends part way through a character:
+        // a character or command (4 bytes, starting with enable high), or a mode byte
+        // together with the character after it
+        make_room(5);
+        size_t room = _capacity - _bufferIn;
+        size_t count = 0;
+        while(count < length) {
+            size_t unit = 4;
+            if(!(wire[count] & ENABLE))
+                unit = count + 1 < length && (wire[count + 1] & ENABLE) ? 5 : 1;
+            if(count + unit > length) {     // a stream cut short. Leave off the broken end.
+                length = count;
+                break;
+            }
+            if(count + unit > room) break;
+            count += unit;
+        }
+        byte *out = &_buffer[_bufferIn];
+        if(_backlight == LCD_BACKLIGHT)
+            memcpy(out, wire, count);   // encoded with the backlight on
+        else
+            for(size_t i = 0; i < count; i++) out[i] = wire[i] & ~LCD_BACKLIGHT;
+        _bufferIn += count;
+        wire += count;
+        length -= count;
+    }
+}
+
+#if LCD_I2C_TEXT_CACHE_ENTRIES
+bool LCD_I2C::write_cached(const char s[])
+{
+    uint32_t hash = 2166136261u;        // FNV-1a
+    size_t length = 0;
+    while(s[length]) {
+        if(length == LCD_I2C_TEXT_CACHE_LENGTH) return false;
+        hash = (hash ^ (byte)s[length++]) * 16777619u;
+    }
+    if(length == 0) return true;
+
+    // Each string may be in either of a pair of entries, and a miss replaces the one used least recently
+    size_t index = hash % LCD_I2C_TEXT_CACHE_ENTRIES;
+    TextCacheEntry *pair[2] = { &_textCache[index], &_textCache[(index ^ 1) % LCD_I2C_TEXT_CACHE_ENTRIES] };
+    TextCacheEntry *found = NULL;
+    for(TextCacheEntry *e : pair)
+        if(e->length == length && e->hash == hash && memcmp(e->text, s, length) == 0) found = e;
+    TextCacheEntry &entry = found ? *found : *(pair[0]->recent ? pair[1] : pair[0]);
+    pair[0]->recent = pair[1]->recent = false;
+    entry.recent = true;
+    if(found) {
+        _cacheHits++;
+    } else {
+        _cacheMisses++;
+        entry.hash = hash;
+        entry.length = length;
+        memcpy(entry.text, s, length);
+        for(size_t i = 0; i < length; i++)
+            encodeByte((byte)s[i], false, &entry.wire[4 * i]);
+    }
+    character_mode();
+    copy_encoded(entry.wire, 4 * length);
+    track_encoded(entry.wire, 4 * length);
+    return true;
+}
+
+void LCD_I2C::clearCache(void)
+{
+    Guard guard(*this);
+    memset(_textCache, 0, sizeof(_textCache));
+    _cacheHits = 0;
+    _cacheMisses = 0;
+}
+#endif
+
 void LCD_I2C::init()
 {
-    _backlight = LCD_BACKLIGHT; // initialize a few variables
-    _displaymode = LCD_ENTRYLEFT | LCD_ENTRYMODESET; // Roman languages
-    _displayfunction = LCD_FUNCTIONSET | LCD_4BITMODE;
-    if(_rows > 1)
-        _displayfunction |= LCD_2LINE;
-    else
-        _displayfunction |= LCD_1LINE;
-    
-    // some 1 line displays allow 10 pixel high characters
-    if(_rows==1 && _charsize!=0)
-        _displayfunction |= LCD_5x10DOTS;
-    else
-        _displayfunction |= LCD_5x8DOTS;
-    
-    _displaycontrol = LCD_DISPLAYCONTROL | LCD_DISPLAYON;
-
-
-
-    // Need to wait 40 ms for display to stabilize    
-
-    sleep_ms(50);                   // Need 40 msec after display power up
-    write_byte(_backlight);         // Set expander interface outputs low with backlight
-    send_byte(0x03, LCD_COMMAND);   // set 4 bit mode three times ...
-    sleep_us(4500);                 // Hitachi HD44780 datasheet pg 46
-    send_byte(0x03, LCD_COMMAND); // two ...
-    sleep_us(4500);
-    send_byte(0x03, LCD_COMMAND); // three
-    sleep_us(150);
-    send_byte(0x02, LCD_COMMAND);
+    for(byte step = 0; step < INIT_STEPS; step++)
+        sleep_us(initStep(step));
+}
 
-    send_byte(_displaymode, LCD_COMMAND);
-    send_byte(_displayfunction, LCD_COMMAND);
-    send_byte(_displaycontrol, LCD_COMMAND);
-    clear();
+uint32_t LCD_I2C::initStep(byte step)
+{
+    Guard guard(*this);
+    switch(step) {
+    case 0:
+        _backlight = LCD_BACKLIGHT; // initialize a few variables
+        _displaymode = LCD_ENTRYLEFT | LCD_ENTRYMODESET; // Roman languages
+        _address = 0;
+        _addressCGRAM = false;
+        _shift = 0;
+        memset(_ddram, ' ', sizeof(_ddram));
+        _displayfunction = LCD_FUNCTIONSET | LCD_4BITMODE;
+        if(_rows > 1)
+            _displayfunction |= LCD_2LINE;
+        else
+            _displayfunction |= LCD_1LINE;
+        
+        // some 1 line displays allow 10 pixel high characters
+        if(_rows==1 && _charsize!=0)
+            _displayfunction |= LCD_5x10DOTS;
+        else
+            _displayfunction |= LCD_5x8DOTS;
+        
+        _displaycontrol = LCD_DISPLAYCONTROL | LCD_DISPLAYON;
+
+        // Need to wait 40 ms for display to stabilize    
+        return 50000;                   // Need 40 msec after display power up
+    case 1:
+        write_byte(_backlight);         // Set expander interface outputs low with backlight
+        send_byte(0x03, LCD_COMMAND);   // set 4 bit mode three times ...
+        return 4500;                    // Hitachi HD44780 datasheet pg 46
+    case 2:
+        send_byte(0x03, LCD_COMMAND);   // two ...
+        return 4500;
+    case 3:
+        send_byte(0x03, LCD_COMMAND);   // three
+        return 150;
+    case 4:
+        send_byte(0x02, LCD_COMMAND, true);
+
+        send_byte(_displaymode, LCD_COMMAND, true);
+        send_byte(_displayfunction, LCD_COMMAND, true);
+        send_byte(_displaycontrol, LCD_COMMAND, true);
+        return startClear();
+    }
+    return 0;
 }
 
 int LCD_I2C::show()  
 {
-    int i = _bufferIn;
+    Guard guard(*this);
+    int i = 0;
+
+    if(_cooperative) return 0;      // only poll() sends
+    if(_lost && (int32_t) (time_us_32() - _probeAt) >= 0) checkConnection();
+    while(backlog()) i += drain_some();
+    return i;
+}
 
-    if(_bufferIn >0) {  //If there is data in the buffer,...
+int LCD_I2C::drain_some(void)
+{
+    wait_hold();
+    return showSome(BUFFER_LENGTH);
+}
 
+void LCD_I2C::wait_hold(void)
+{
+    if(_holding) {          // wait out a slow command
+        int32_t left = _holdUntil - time_us_32();
+        if(left > 0) sleep_us(left);
+        _holding = false;
+    }
+}
+
+bool LCD_I2C::holding(void)
+{
+    if(_holding && (int32_t) (time_us_32() - _holdUntil) < 0) return true;
+    _holding = false;
+    return false;
+}
+
+size_t LCD_I2C::safe_length(size_t max_bytes) const
+{
+    size_t limit = _bufferIn - _bufferOut;
+    size_t safe = 0;
+    byte enables = 0;
+
+    if(_holds && limit > _holdAt[0] - _bufferOut) limit = _holdAt[0] - _bufferOut;
+    if(limit > max_bytes) limit = max_bytes;
+    // A safe place is after enable has dropped on the second (low) nibble, 
+    // or after a byte which is not part of a nibble pair at all.
+    for(size_t i = 0; i < limit; i++) {
+        byte b = _buffer[_bufferOut + i];
+        if(b & ENABLE) enables++;
+        else if(enables % 2 == 0) safe = i + 1;
+    }
+    return safe;
+}
+
+void LCD_I2C::make_room(size_t count)
+{
+    #if LCD_I2C_BUFFER_POOL
+    if(_bufferIn == 0) borrow_buffer();
+    #endif
+    if(_capacity - _bufferIn >= count) return;
+    if(!_cooperative) {
+        show();             // OOPS! It is too full, empty it NOW
+        return;
+    }
+    // Move the backlog to the front, and send only as much as we must
+    if(_bufferOut) {
+        memmove(_buffer, &_buffer[_bufferOut], _bufferIn - _bufferOut);
+        for(byte h = 0; h < _holds; h++) _holdAt[h] -= _bufferOut;
+        _bufferIn -= _bufferOut;
+        _bufferOut = 0;
+    }
+    while(_capacity - _bufferIn + _bufferOut < count) {
+        wait_hold();
+        showSome(5);        // a whole character or command
+    }
+    if(_bufferOut) make_room(count);    // move the rest down
+}
+
+void LCD_I2C::setCooperative(bool on)
+{
+    Guard guard(*this);
+    _cooperative = on;
+}
+
+int LCD_I2C::poll(size_t max_bytes, uint32_t max_us)
+{
+    Guard guard(*this);
+    uint32_t start = time_us_32();
+    size_t sent = 0;
+
+    while(backlog() && sent < max_bytes && !holding()) {
+        size_t allowed = max_bytes - sent;
+        if(max_us) {
+            // Estimate how many bytes fit in the time left, counting the address byte
+            uint32_t used = time_us_32() - start;
+            if(used >= max_us) break;
+            size_t fit = (max_us - used) * 16 / _usPerByte16;
+            if(fit < 2) break;
+            if(allowed > fit - 1) allowed = fit - 1;
+        }
+        int i = showSome(allowed);
+        if(i == 0) break;
+        sent += i;
+    }
+    return sent;
+}
+
+int LCD_I2C::showSome(size_t max_bytes)
+{
+    Guard guard(*this);
+    if(holding()) return 0;
+    size_t i = safe_length(max_bytes);
+
+    if(i >0 && !_lost) {  //If there is data in the buffer,...
+
+        uint32_t begin = time_us_32();
         // For Arduino, we need to end transmission to send it.
         #ifdef ARDUINO
         Wire.beginTransmission(_Addr);
-        Wire.write(_buffer,_bufferIn);
-        Wire.endTransmission();
+        Wire.write(&_buffer[_bufferOut],i);
+        bool ok = Wire.endTransmission() == 0;
         #else
         // For Pi Pico, we do an I2C write pointing at our own buffer
-        i2c_write_blocking(I2C_instance, _Addr, _buffer, _bufferIn, false);
+        bool ok = i2c_write_blocking(I2C_instance, _Addr, &_buffer[_bufferOut], i, false) == (int) i;
+        #endif
+        if(!ok) lost_connection();
+        else {
+            // Keep a running measurement of the time per byte on the bus, in 1/16 us
+            uint32_t measured = (time_us_32() - begin) * 16 / (i + 1);
+            _usPerByte16 = (3 * _usPerByte16 + measured + 3) / 4;
+        }
+    }
+    if(_lost) {                 // drop everything. The copy of the screen still has it.
+        i = _bufferIn - _bufferOut;
+        _holds = 0;
+    }
+    _bufferOut += i;
+    if(_holds && _bufferOut == _holdAt[0]) {   // a slow command just went
+        _holding = true;
+        _holdUntil = time_us_32() + CLEAR_TIME_US;
+        _holds--;
+        for(byte h = 0; h < _holds; h++) _holdAt[h] = _holdAt[h + 1];
+    }
+    if(_bufferOut == _bufferIn) {
+        _bufferIn = _bufferOut = 0;  // and set the buffer to empty
+        #if LCD_I2C_BUFFER_POOL
+        return_buffer();
         #endif
     }
-    _bufferIn = 0;  // and set the buffer to empty
     return i;
+}
+
+// connection and recovery
+
+bool LCD_I2C::probe(void)
+{
+    byte data = _backlight;     // all the display lines low
+    #ifdef ARDUINO
+    Wire.beginTransmission(_Addr);
+    Wire.write(&data, 1);
+    return Wire.endTransmission() == 0;
+    #else
+    return i2c_write_blocking(I2C_instance, _Addr, &data, 1, false) == 1;
+    #endif
+}
+
+void LCD_I2C::lost_connection(void)
+{
+    if(!_lost) _lostAt = time_us_32();
+    _lost = true;
+    _probeAt = time_us_32() + PROBE_INTERVAL_US;
+}
+
+bool LCD_I2C::checkConnection(void)
+{
+    Guard guard(*this);
+    if(!probe()) {
+        lost_connection();
+        return false;
+    }
+    if(_lost) recover();
+    return !_lost;
+}
+
+void LCD_I2C::recover(void)
+{
+    uint32_t start = time_us_32();
+    _outageUs = start - _lostAt;
+    _lost = false;
 
+    // Whatever was waiting to be sent is already in the copy
+    _bufferIn = _bufferOut = 0;
+    _holds = 0;
+    _holding = false;
+    #if LCD_I2C_BUFFER_POOL
+    return_buffer();
+    #endif
+
+    // Save the state, since initializing the display clears it
+    byte ddram[DDRAM_SIZE];
+    memcpy(ddram, _ddram, sizeof(ddram));
+    byte mode = _displaymode, control = _displaycontrol, address = _address, shift = _shift;
+    bool cooperative = _cooperative;
+    _cooperative = false;
+
+    // Initialize with the display off and no autoscroll while it is redrawn
+    _displaymode = LCD_ENTRYLEFT | LCD_ENTRYMODESET;
+    _displaycontrol = LCD_DISPLAYCONTROL | LCD_DISPLAYOFF;
+    sleep_us(50000);                    // the display may have just powered up
+    for(byte step = 1; step < INIT_STEPS; step++)
+        sleep_us(initStep(step));
+
+    // The custom characters which were loaded, with one address for each run of them
+    for(byte c = 0; c < MAX_CUSTOM_CHARS; c++) {
+        if(!(_cgramValid & (1 << c))) continue;
+        if(c == 0 || !(_cgramValid & (1 << (c - 1))))
+            send_byte(LCD_SETCGRAMADDR | (c * CUSTOM_CHAR_ROWS), LCD_COMMAND, true);
+        for(byte r = 0; r < CUSTOM_CHAR_ROWS; r++) send_byte(_cgram[c][r], LCD_CHARACTER, true);
+    }
+
+    // The display RAM. Only the text needs sending, since the display was cleared.
+    // A single space is sent along, since it is cheaper than a new address.
+    for(byte line = 0; line < 2; line++) {
+        const byte *text = &ddram[line * DDRAM_LINE_LENGTH];
+        byte col = 0;
+        while(col < DDRAM_LINE_LENGTH) {
+            if(text[col] == ' ') {
+                col++;
+                continue;
+            }
+            byte end = col + 1;
+            while(end < DDRAM_LINE_LENGTH && (text[end] != ' ' ||
+                    (end + 1 < DDRAM_LINE_LENGTH && text[end + 1] != ' '))) end++;
+            send_byte(LCD_SETDDRAMADDR | (line * 0x40 + col), LCD_COMMAND, true);
+            for(; col < end; col++) send_byte(text[col], LCD_CHARACTER, true);
+        }
+    }
+
+    // The display shift, whichever way is shorter
+    bool left = shift <= DDRAM_LINE_LENGTH / 2;
+    for(byte n = left ? shift : DDRAM_LINE_LENGTH - shift; n > 0; n--)
+        send_byte(LCD_DISPLAYSHIFT | LCD_DISPLAYMOVE | (left ? LCD_MOVELEFT : LCD_MOVERIGHT), LCD_COMMAND, true);
+
+    // And the modes and cursor
+    _displaymode = mode;
+    _displaycontrol = control;
+    send_byte(_displaymode, LCD_COMMAND, true);
+    send_byte(_displaycontrol, LCD_COMMAND, true);
+    send_byte(LCD_SETDDRAMADDR | address, LCD_COMMAND, true);
+    show();
+
+    _cooperative = cooperative;
+    if(_lost) return;                   // gone again
+    _recoveryUs = time_us_32() - start;
+    _recoveries++;
 }
 
 void LCD_I2C::backlight(void)
 {
+    Guard guard(*this);
     _backlight = LCD_BACKLIGHT;
     write_byte(_backlight); // Send interface command
 }
 
 void LCD_I2C::noBacklight()
 {
+    Guard guard(*this);
     _backlight = LCD_NOBACKLIGHT;
     write_byte(_backlight); //Send interface command
 }
 
 void LCD_I2C::cursor(void)
 {
+    Guard guard(*this);
     _displaycontrol |= LCD_CURSORON;
     send_byte(_displaycontrol,LCD_COMMAND);
 }
 
 void LCD_I2C::noCursor(void)
 {
+    Guard guard(*this);
     _displaycontrol &= ~LCD_CURSORON;
     send_byte(_displaycontrol,LCD_COMMAND);
 }
 
 void LCD_I2C::blink(void)
 {
+    Guard guard(*this);
     _displaycontrol |= LCD_BLINKON;
     send_byte(_displaycontrol,LCD_COMMAND);
 }
 
 void LCD_I2C::noBlink(void)
 {
+    Guard guard(*this);
     _displaycontrol &= ~LCD_BLINKON;
     send_byte(_displaycontrol,LCD_COMMAND);
 }
 
 void LCD_I2C::display(void)
 {
+    Guard guard(*this);
     _displaycontrol |= LCD_DISPLAYON;
     send_byte(_displaycontrol,LCD_COMMAND);
 }
 
 void LCD_I2C::noDisplay(void)
 {
+    Guard guard(*this);
     _displaycontrol &= ~LCD_DISPLAYON;
     send_byte(_displaycontrol,LCD_COMMAND);
 }
 
-void LCD_I2C::scrollDisplayLeft(void)
+void LCD_I2C::scrollDisplayLeft(bool Enable_Buffering)
 {
-    send_byte(LCD_DISPLAYSHIFT | LCD_DISPLAYMOVE | LCD_MOVELEFT, LCD_COMMAND);
+    Guard guard(*this);
+    send_byte(LCD_DISPLAYSHIFT | LCD_DISPLAYMOVE | LCD_MOVELEFT, LCD_COMMAND, Enable_Buffering);
 }
 
-void LCD_I2C::scrollDisplayRight(void)
+void LCD_I2C::scrollDisplayRight(bool Enable_Buffering)
 {
-    send_byte(LCD_DISPLAYSHIFT | LCD_DISPLAYMOVE | LCD_MOVERIGHT, LCD_COMMAND);
+    Guard guard(*this);
+    send_byte(LCD_DISPLAYSHIFT | LCD_DISPLAYMOVE | LCD_MOVERIGHT, LCD_COMMAND, Enable_Buffering);
 }
 
 void LCD_I2C::autoscroll(void)
 {
+    Guard guard(*this);
     _displaymode |= LCD_DISPLAYENTRYSHIFT;
     send_byte(_displaymode, LCD_COMMAND);
 }
 
 void LCD_I2C::noAutoscroll(void)
 {
+    Guard guard(*this);
     _displaymode &= ~LCD_DISPLAYENTRYSHIFT;
     send_byte(_displaymode, LCD_COMMAND);
 }
 
 void LCD_I2C::rightToLeft(void)
 {
+    Guard guard(*this);
     _displaymode &= ~LCD_ENTRYLEFT;
     send_byte(_displaymode, LCD_COMMAND);
 }
 
 void LCD_I2C::leftToRight(void)
 {
+    Guard guard(*this);
     _displaymode |= LCD_ENTRYLEFT;
     send_byte(_displaymode, LCD_COMMAND);
 }
 
 void LCD_I2C::createChar(byte charnum, const byte char_map[])
 {
+    Guard guard(*this);
     #define MAXCHARNUM 7
     #define CUSTOMCHARSIZE 8
     if(charnum > MAXCHARNUM) charnum = MAXCHARNUM;
     send_byte(LCD_SETCGRAMADDR | charnum << 3, LCD_COMMAND,true);   // set ram address
     for(int i=0;i<CUSTOMCHARSIZE;i++) {
         send_byte(char_map[i], LCD_CHARACTER, true);
+        _cgram[charnum][i] = char_map[i] & 0x1f;   // remember what the display has
     }
+    _cgramValid |= 1 << charnum;
     setCursor(0,0); // go back to data ram addressing (and flush buffer)
 }
 
+int LCD_I2C::send_char_rows(byte first, byte count, const byte *char_maps)
+{
+    if(first >= MAX_CUSTOM_CHARS) first = MAX_CUSTOM_CHARS-1;
+    if(count > MAX_CUSTOM_CHARS - first) count = MAX_CUSTOM_CHARS - first;
+
+    // The characters are stored one after the other, so treat them as one block of rows
+    byte *shadow = _cgram[first];
+    int rows = count * CUSTOM_CHAR_ROWS;
+    uint64_t changed = 0;
+    int sent = 0;
+
+    for(int i = 0; i < rows; i++) {
+        if(!(_cgramValid & (1 << (first + i / CUSTOM_CHAR_ROWS))) || shadow[i] != (char_maps[i] & 0x1f))
+            changed |= (uint64_t) 1 << i;
+    }
+
+    int row = 0;
+    while(row < rows) {
+        if(!(changed >> row & 1)) {     // skip unchanged rows
+            row++;
+            continue;
+        }
+        // Find the end of this run. A single unchanged row costs the same 4 bytes as a 
+        // new address command (without the mode switches), so we just send it along.
+        int end = row + 1;
+        while(end < rows) {
+            if(changed >> end & 1) end++;
+            else if(end + 1 < rows && (changed >> (end+1) & 1)) end += 2;
+            else break;
+        }
+        send_byte(LCD_SETCGRAMADDR | (first * CUSTOM_CHAR_ROWS + row), LCD_COMMAND, true);  // first row of run
+        for(; row < end; row++, sent++) {
+            shadow[row] = char_maps[row] & 0x1f;
+            send_byte(shadow[row], LCD_CHARACTER, true);
+        }
+    }
+    for(int i = 0; i < count; i++) _cgramValid |= 1 << (first + i);
+    return sent;
+}
+
+int LCD_I2C::updateChar(byte charnum, const byte char_map[], bool Enable_Buffering)
+{
+    Guard guard(*this);
+    int sent = send_char_rows(charnum, 1, char_map);
+
+    if(sent) setCursor(0, 0, Enable_Buffering);  // go back to data ram addressing
+    else if(!Enable_Buffering) show();
+    return sent;
+}
+
+int LCD_I2C::updateChars(byte first, byte count, const byte char_maps[][CUSTOM_CHAR_ROWS], bool Enable_Buffering)
+{
+    Guard guard(*this);
+    int sent = send_char_rows(first, count, char_maps[0]);
+
+    if(sent) setCursor(0, 0, Enable_Buffering);  // go back to data ram addressing
+    else if(!Enable_Buffering) show();
+    return sent;
+}
+
 #ifndef ARDUINO
 extern "C" int LCD_I2C_Setup(i2c_inst_t* I2C, uint SDA_Pin, uint SCL_Pin, uint I2C_Clock) {
 
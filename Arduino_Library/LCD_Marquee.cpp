@@ -0,0 +1,93 @@
+/**
+ * @file LCD_Marquee.cpp
+ * @author Keith Standiford
+ * @brief A scrolling marquee using the display's hardware shift, for the Fast LCD I2C driver
+ * @version 1.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2022 Keith Standiford. All rights reserved. 
+ * 
+ */
+
+#ifdef ARDUINO
+#include "LCD_Marquee.h"
+#else
+#include <LCD_Marquee.hpp>
+#endif
+
+
+LCD_Marquee::LCD_Marquee(LCD_I2C &lcd, byte line, byte gap, byte refill) :
+    _lcd(lcd), _line(line), _gap(gap), _refill(refill)
+{
+    if(_line >= _lcd.rows()) _line = _lcd.rows() - 1;
+    _hardware = _lcd.rows() <= 2;
+    // we can't refill more than the hidden part of the line
+    byte hidden = RAM_LENGTH - _lcd.columns();
+    if(_refill > hidden) _refill = hidden;
+    if(_refill < 1) _refill = 1;
+}
+
+LCD_Marquee::byte LCD_Marquee::at(uint32_t index) const
+{
+    index %= _period;
+    return index < _length ? _text[index] : ' ';
+}
+
+void LCD_Marquee::load(uint32_t end)
+{
+    byte data[RAM_LENGTH];
+
+    // The message wraps around the display RAM line, so we may need two pieces
+    while(_valid < end) {
+        byte first = _valid % RAM_LENGTH;
+        byte count = end - _valid;
+        if(count > RAM_LENGTH - first) count = RAM_LENGTH - first;
+        for(byte i = 0; i < count; i++) data[i] = at(_valid + i);
+        _lcd.writeChanges(_line, first, data, &_shown[first], count, true);
+        _valid += count;
+    }
+}
+
+void LCD_Marquee::start(const char text[], bool Enable_Buffering)
+{
+    _text = text == NULL ? "" : text;
+    _length = strlen(_text);
+    _period = _length + _gap;
+    // If it fits, stretch the gap so the message repeats exactly every display RAM line.
+    // Then the text wraps through by itself and nothing ever needs to be refilled.
+    if(_hardware && _period <= RAM_LENGTH) _period = RAM_LENGTH;
+    if(_period == 0) _period = 1;
+    _offset = 0;
+
+    _lcd.home();    // no shift, so display RAM position 0 is at the left edge
+    for(byte i = 0; i < RAM_LENGTH; i++) _shown[i] = ~at(i);   // force every character
+    _valid = 0;
+    load(_hardware ? RAM_LENGTH : _lcd.columns());
+    if(!Enable_Buffering) _lcd.show();
+}
+
+void LCD_Marquee::step(bool Enable_Buffering)
+{
+    if(_text == NULL) return;
+    _offset++;
+    if(_hardware) {
+        _lcd.scrollDisplayLeft(true);
+        // The character which just scrolled off the left edge is now the last hidden one.
+        // Refill the hidden characters in batches, but always before they come into view.
+        uint32_t end = _offset + RAM_LENGTH;
+        if(end - _valid >= _refill || _valid <= _offset + _lcd.columns()) load(end);
+    } else {
+        // No hidden display RAM. Just rewrite the characters which change.
+        _valid = _offset;
+        byte data[RAM_LENGTH];
+        for(byte i = 0; i < _lcd.columns(); i++) data[i] = at(_offset + i);
+        _lcd.writeChanges(_line, 0, data, _shown, _lcd.columns(), true);
+    }
+    if(!Enable_Buffering) _lcd.show();
+}
+
+void LCD_Marquee::stop(void)
+{
+    _lcd.home();
+    _text = NULL;
+}
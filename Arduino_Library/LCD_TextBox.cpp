@@ -0,0 +1,104 @@
+/**
+ * @file LCD_TextBox.cpp
+ * @author Keith Standiford
+ * @brief Text laid out in a box: aligned, wrapped and cut to fit
+ * @version 1.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2022 Keith Standiford. All rights reserved. 
+ * 
+ */
+
+#ifdef ARDUINO
+#include "LCD_TextBox.h"
+#else
+#include <LCD_TextBox.hpp>
+#endif
+
+
+LCD_TextBox::LCD_TextBox(LCD_I2C &lcd, byte line, byte position, byte width, byte height,
+        Align align, byte options) :
+    _lcd(lcd), _line(line), _position(position), _width(width), _height(height),
+    _align(align), _options(options)
+{
+    // Keep the box on the display
+    byte columns = _lcd.columns() < MAX_CHARS ? _lcd.columns() : MAX_CHARS;
+    byte rows = _lcd.rows() < MAX_LINES ? _lcd.rows() : MAX_LINES;
+    if(_position >= columns || _line >= rows) _width = _height = 0;
+    if(_width > columns - _position) _width = columns - _position;
+    if(_height > rows - _line) _height = rows - _line;
+    memset(_shown, ' ', sizeof(_shown));
+}
+
+void LCD_TextBox::invalidate(bool blank)
+{
+    memset(_shown, ' ', sizeof(_shown));
+    _stale = !blank;
+}
+
+const char *LCD_TextBox::layout(const char *p, byte row[], bool last) const
+{
+    bool wrap = _options & WRAP;
+    size_t n = 0;
+    while(p[n] && p[n] != '\n' && n < _width) n++;
+
+    // Where the next line starts, and whether some of this one is cut off
+    const char *next = p + n;
+    bool cut = false;
+    if(*next == '\n') {
+        next++;
+    } else if(*next) {
+        if(!wrap) {
+            cut = true;
+            while(*next && *next != '\n') next++;
+            if(*next) next++;
+        } else if(*next != ' ') {
+            // Break after the last space that fits, unless the word is longer than the line
+            size_t k = n;
+            while(k && p[k-1] != ' ') k--;
+            if(k) {
+                n = k;
+                next = p + k;
+            }
+        }
+    }
+    if(wrap) {
+        while(n && p[n-1] == ' ') n--;
+        while(*next == ' ') next++;
+    }
+
+    // Anything left for the last line is cut off too
+    if(last && *next) cut = true;
+    byte dots = 0;
+    if(cut && (_options & ELLIPSIS)) {
+        dots = _width < 3 ? _width : 3;
+        if(n > (size_t)(_width - dots)) n = _width - dots;
+        while(n && p[n-1] == ' ') n--;
+    }
+
+    byte length = n + dots;
+    byte offset = _align == LEFT ? 0 : _align == RIGHT ? _width - length : (_width - length) / 2;
+    memset(row, ' ', _width);
+    memcpy(&row[offset], p, n);
+    memset(&row[offset + n], '.', dots);
+    return next;
+}
+
+int LCD_TextBox::setText(const char text[], bool Enable_Buffering)
+{
+    LCD_I2C::Guard guard(_lcd);     // keep the box together
+    byte row[MAX_CHARS];
+    const char *p = text ? text : "";
+    int sent = 0;
+
+    for(byte i = 0; i < _height; i++) {
+        p = layout(p, row, i == _height - 1);
+        if(_stale) {                // make every cell look changed
+            for(byte j = 0; j < _width; j++) _shown[i][j] = ~row[j];
+        }
+        sent += _lcd.writeChanges(_line + i, _position, row, _shown[i], _width, true);
+    }
+    _stale = false;
+    if(!Enable_Buffering) _lcd.show();
+    return sent;
+}
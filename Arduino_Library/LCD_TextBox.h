@@ -0,0 +1,142 @@
+/**
+ * @file LCD_TextBox.hpp
+ * @author Keith Standiford
+ * @brief Text laid out in a box: aligned, wrapped and cut to fit
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022 Keith Standiford. All rights reserved.
+ * @remark Compiles for Arduino or for Pi Pico
+ *
+ */
+#pragma once
+
+#ifdef ARDUINO
+#include "LCD_I2C.h"
+#else
+#include <string.h>
+#include <hardware/i2c.h>
+#include <LCD_I2C.hpp>
+#endif
+
+/**
+ * @brief A box on the screen which text of any length is laid out in.
+ *
+ * The text is aligned left, centered or aligned right on each line of the box. With WRAP,
+ * it is broken between words onto the lines which follow, and a newline starts a new line.
+ * Without WRAP, each line of the box shows one line of the text. With ELLIPSIS, text which
+ * does not fit ends in "..." instead of just being cut off.
+ *
+ * The box remembers what it last showed and only the cells which change are sent. So there is
+ * no need to pad the text with spaces: a shorter text only blanks the cells where the old one
+ * was longer, and the cells which stay the same are not sent at all.
+ *
+ * Nothing is allocated. The layout is done a line at a time on the stack.
+ *
+ * @code
+ * LCD_TextBox status(lcd, 1, 0, 20, 2, LCD_TextBox::CENTER, LCD_TextBox::WRAP | LCD_TextBox::ELLIPSIS);
+ * status.setText("Filter needs cleaning soon");    // "Filter needs" / "cleaning soon"
+ * status.setText("Ready");                         // blanks only what is left over
+ * @endcode
+ *
+ * @note Line and position are in the *same* order on Arduino and Pi Pico.
+ */
+class LCD_TextBox {
+ public:
+
+    using byte = uint8_t;
+
+    /** @brief Where the text goes on each line */
+    enum Align : byte {
+        LEFT,           ///< Against the left edge
+        CENTER,         ///< In the middle, a space further left if it cannot be exact
+        RIGHT           ///< Against the right edge
+    };
+
+    /** @brief Options for the layout, which can be combined with | */
+    enum Options : byte {
+        WRAP = 1,       ///< Break text between words onto the next line
+        ELLIPSIS = 2    ///< End text which does not fit with "..."
+    };
+
+    /**
+     * @brief Construct a box. Nothing is sent to the display, which is assumed blank there.
+     *
+     * @param lcd The display to draw on
+     * @param line The row (or line) of the top left cell
+     * @param position The position (or column) of the top left cell
+     * @param width The width of the box, up to 20
+     * @param height The height of the box, up to 4
+     * @param align LEFT, CENTER or RIGHT
+     * @param options WRAP and ELLIPSIS, or 0 for neither
+     */
+    LCD_TextBox(LCD_I2C &lcd, byte line, byte position, byte width, byte height = 1,
+            Align align = LEFT, byte options = 0) noexcept;
+
+    /**
+     * @brief Change the alignment. It takes effect at the next setText().
+     *
+     * @param align LEFT, CENTER or RIGHT
+     */
+    inline void setAlign(Align align) noexcept
+    { _align = align; }
+
+    /**
+     * @brief Change the options. They take effect at the next setText().
+     *
+     * @param options WRAP and ELLIPSIS, or 0 for neither
+     */
+    inline void setOptions(byte options) noexcept
+    { _options = options; }
+
+    /**
+     * @brief Lay out text in the box and send the cells which change.
+     *
+     * @param text The text. NULL or "" blanks the box.
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display.
+     * @return (int) The number of characters sent
+     */
+    int setText(const char text[], bool Enable_Buffering = false) noexcept;
+
+    /**
+     * @brief Blank the box, sending only the cells which are not already blank.
+     *
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display.
+     * @return (int) The number of characters sent
+     */
+    inline int clear(bool Enable_Buffering = false) noexcept
+    { return setText(NULL, Enable_Buffering); }
+
+    /**
+     * @brief Forget what the box showed, so the next setText() sends every cell.
+     *
+     * Use it when something else has written over the box, or cleared the screen.
+     *
+     * @param blank True if the box is now known to be blank, for example after a clear()
+     * of the display. Then only the text itself is sent.
+     */
+    void invalidate(bool blank = false) noexcept;
+
+ private:
+
+    static constexpr byte MAX_LINES = 4;
+    static constexpr byte MAX_CHARS = 20;
+
+    LCD_I2C &_lcd;
+    byte _line;
+    byte _position;
+    byte _width;
+    byte _height;
+    Align _align;
+    byte _options;
+    byte _shown[MAX_LINES][MAX_CHARS];      // what the box shows now
+    bool _stale = false;                    // true if _shown cannot be trusted
+
+    // Lay out the line of text starting at p into row, which is _width cells.
+    // Returns where the text for the next line starts.
+    const char *layout(const char *p, byte row[], bool last) const noexcept;
+};
@@ -0,0 +1,192 @@
+/**
+ * @file LCD_UTF8.cpp
+ * @author Keith Standiford
+ * @brief UTF-8 text for the Fast LCD I2C driver
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022 Keith Standiford. All rights reserved.
+ * @remark Compiles for Arduino or for Pi Pico
+ *
+ */
+
+#ifdef ARDUINO
+#include "LCD_I2C.h"
+#else
+#include <string.h>
+#include <hardware/i2c.h>
+#include <LCD_I2C.hpp>
+#endif
+
+using byte = uint8_t;
+
+/*
+ * The character ROM tables, sorted by Unicode character.
+ */
+struct RomCode {
+    uint16_t unicode;
+    byte code;
+};
+
+// A00 (Japanese). The half width katakana (U+FF61-U+FF9F) are a range, handled in rom_code().
+static constexpr RomCode rom_a00[] = {
+    {0x00A2, 0xEC}, {0x00A3, 0xED}, {0x00A5, 0x5C}, {0x00B0, 0xDF}, {0x00B5, 0xE4},
+    {0x00DF, 0xE2}, {0x00E4, 0xE1}, {0x00F1, 0xEE}, {0x00F6, 0xEF}, {0x00F7, 0xFD},
+    {0x00FC, 0xF5}, {0x03A3, 0xF6}, {0x03A9, 0xF4}, {0x03B1, 0xE0}, {0x03B2, 0xE2},
+    {0x03B5, 0xE3}, {0x03B8, 0xF2}, {0x03BC, 0xE4}, {0x03C0, 0xF7}, {0x03C1, 0xE6},
+    {0x03C3, 0xE5}, {0x2126, 0xF4}, {0x2190, 0x7F}, {0x2192, 0x7E}, {0x221A, 0xE8},
+    {0x221E, 0xF3}, {0x2588, 0xFF}, {0x3001, 0xA4}, {0x3002, 0xA1}, {0x300C, 0xA2},
+    {0x300D, 0xA3}, {0x309B, 0xDE}, {0x309C, 0xDF}, {0x30A1, 0xA7}, {0x30A2, 0xB1},
+    {0x30A3, 0xA8}, {0x30A4, 0xB2}, {0x30A5, 0xA9}, {0x30A6, 0xB3}, {0x30A7, 0xAA},
+    {0x30A8, 0xB4}, {0x30A9, 0xAB}, {0x30AA, 0xB5}, {0x30AB, 0xB6}, {0x30AD, 0xB7},
+    {0x30AF, 0xB8}, {0x30B1, 0xB9}, {0x30B3, 0xBA}, {0x30B5, 0xBB}, {0x30B7, 0xBC},
+    {0x30B9, 0xBD}, {0x30BB, 0xBE}, {0x30BD, 0xBF}, {0x30BF, 0xC0}, {0x30C1, 0xC1},
+    {0x30C3, 0xAF}, {0x30C4, 0xC2}, {0x30C6, 0xC3}, {0x30C8, 0xC4}, {0x30CA, 0xC5},
+    {0x30CB, 0xC6}, {0x30CC, 0xC7}, {0x30CD, 0xC8}, {0x30CE, 0xC9}, {0x30CF, 0xCA},
+    {0x30D2, 0xCB}, {0x30D5, 0xCC}, {0x30D8, 0xCD}, {0x30DB, 0xCE}, {0x30DE, 0xCF},
+    {0x30DF, 0xD0}, {0x30E0, 0xD1}, {0x30E1, 0xD2}, {0x30E2, 0xD3}, {0x30E3, 0xAC},
+    {0x30E4, 0xD4}, {0x30E5, 0xAD}, {0x30E6, 0xD5}, {0x30E7, 0xAE}, {0x30E8, 0xD6},
+    {0x30E9, 0xD7}, {0x30EA, 0xD8}, {0x30EB, 0xD9}, {0x30EC, 0xDA}, {0x30ED, 0xDB},
+    {0x30EF, 0xDC}, {0x30F2, 0xA6}, {0x30F3, 0xDD}, {0x30FB, 0xA5}, {0x30FC, 0xB0},
+    {0x4E07, 0xFB}, {0x5186, 0xFC}, {0x5343, 0xFA},
+};
+
+// A02 (European). Latin-1 (U+00A0-U+00FF) is a range, handled in rom_code().
+static constexpr RomCode rom_a02[] = {
+    {0x2588, 0xFF},
+};
+
+/*
+ * Glyphs for characters missing from one ROM or the other, sorted by Unicode character.
+ * Each is a 5x8 bitmap like createChar() takes.
+ */
+struct Glyph {
+    uint16_t unicode;
+    byte rows[LCD_I2C::CUSTOM_SYMBOL_SIZE];
+};
+
+static constexpr Glyph glyphs[] = {
+    {0x005C, {0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00, 0x00}},     // back slash
+    {0x007E, {0x00, 0x00, 0x08, 0x15, 0x02, 0x00, 0x00, 0x00}},     // ~
+    {0x00B0, {0x0C, 0x12, 0x12, 0x0C, 0x00, 0x00, 0x00, 0x00}},     // degree
+    {0x00C4, {0x0A, 0x00, 0x0E, 0x11, 0x1F, 0x11, 0x11, 0x00}},     // A umlaut
+    {0x00D6, {0x0A, 0x00, 0x0E, 0x11, 0x11, 0x11, 0x0E, 0x00}},     // O umlaut
+    {0x00DC, {0x0A, 0x00, 0x11, 0x11, 0x11, 0x11, 0x0E, 0x00}},     // U umlaut
+    {0x00E0, {0x08, 0x04, 0x0E, 0x01, 0x0F, 0x11, 0x0F, 0x00}},     // a grave
+    {0x00E7, {0x00, 0x0E, 0x10, 0x10, 0x11, 0x0E, 0x04, 0x0C}},     // c cedilla
+    {0x00E8, {0x08, 0x04, 0x0E, 0x11, 0x1F, 0x10, 0x0E, 0x00}},     // e grave
+    {0x00E9, {0x02, 0x04, 0x0E, 0x11, 0x1F, 0x10, 0x0E, 0x00}},     // e acute
+    {0x03A9, {0x00, 0x0E, 0x11, 0x11, 0x11, 0x0A, 0x1B, 0x00}},     // Omega
+    {0x20AC, {0x07, 0x08, 0x1E, 0x08, 0x1E, 0x08, 0x07, 0x00}},     // Euro
+    {0x2126, {0x00, 0x0E, 0x11, 0x11, 0x11, 0x0A, 0x1B, 0x00}},     // Ohm
+    {0x2190, {0x00, 0x04, 0x08, 0x1F, 0x08, 0x04, 0x00, 0x00}},     // left arrow
+    {0x2191, {0x04, 0x0E, 0x15, 0x04, 0x04, 0x04, 0x04, 0x00}},     // up arrow
+    {0x2192, {0x00, 0x04, 0x02, 0x1F, 0x02, 0x04, 0x00, 0x00}},     // right arrow
+    {0x2193, {0x04, 0x04, 0x04, 0x04, 0x15, 0x0E, 0x04, 0x00}},     // down arrow
+};
+
+// Binary search of a table sorted by unicode. Returns NULL if it is not there.
+template <typename T, size_t N>
+static const T *find(const T (&table)[N], uint32_t unicode)
+{
+    size_t low = 0, high = N;
+    while(low < high) {
+        size_t mid = (low + high) / 2;
+        if(table[mid].unicode < unicode) low = mid + 1;
+        else high = mid;
+    }
+    return low < N && table[low].unicode == unicode ? &table[low] : NULL;
+}
+
+// The ROM code for a character, or -1 if the ROM does not have it
+static int rom_code(uint32_t unicode, byte rom)
+{
+    if(unicode < 0x20) return unicode;      // custom characters
+    if(rom == LCD_I2C::ROM_A00) {
+        if(unicode < 0x7E && unicode != '\\') return unicode;
+        if(unicode >= 0xFF61 && unicode <= 0xFF9F) return unicode - 0xFF61 + 0xA1;
+        const RomCode *r = find(rom_a00, unicode);
+        return r ? r->code : -1;
+    }
+    if(unicode < 0x7F) return unicode;
+    if(unicode >= 0xA0 && unicode <= 0xFF) return unicode;
+    const RomCode *r = find(rom_a02, unicode);
+    return r ? r->code : -1;
+}
+
+void LCD_I2C::setGlyphSlots(byte first, byte count)
+{
+    Guard guard(*this);
+    if(first >= MAX_CUSTOM_CHARS) count = 0;
+    if(count > MAX_CUSTOM_CHARS - first) count = MAX_CUSTOM_CHARS - first;
+    _glyphFirst = first;
+    _glyphCount = count;
+    memset(_glyphChar, 0, sizeof(_glyphChar));
+    memset(_glyphUsed, 0, sizeof(_glyphUsed));
+}
+
+byte LCD_I2C::utf8_code(uint32_t unicode)
+{
+    int code = rom_code(unicode, _rom);
+    if(code >= 0) return code;
+
+    const Glyph *glyph = unicode <= 0xFFFF ? find(glyphs, unicode) : NULL;
+    if(glyph == NULL || _glyphCount == 0) return '?';
+
+    // Already loaded? Otherwise replace the slot used longest ago, but not one used in this call.
+    int slot = -1;
+    uint16_t oldest = 0;
+    for(byte s = _glyphFirst; s < _glyphFirst + _glyphCount; s++) {
+        if(_glyphChar[s] == unicode) {
+            _glyphUsed[s] = _utf8Calls;
+            return s;
+        }
+        uint16_t age = _utf8Calls - _glyphUsed[s];
+        if(age > oldest) {
+            oldest = age;
+            slot = s;
+        }
+    }
+    if(slot < 0) return '?';        // every slot is in use by this call
+
+    _glyphChar[slot] = unicode;
+    _glyphUsed[slot] = _utf8Calls;
+    if(send_char_rows(slot, 1, glyph->rows))                    // leaves us addressing CGRAM
+        send_byte(LCD_SETDDRAMADDR | _address, LCD_COMMAND, true);  // so go back where we were
+    return slot;
+}
+
+size_t LCD_I2C::writeUTF8(const char s[], bool Enable_Buffering)
+{
+    Guard guard(*this);
+    size_t cells = 0;
+    if(++_utf8Calls == 0) {         // keep the ages simple when the count wraps
+        memset(_glyphUsed, 0, sizeof(_glyphUsed));
+        _utf8Calls = 1;
+    }
+
+    const byte *p = (const byte *)s;
+    while(p != NULL && *p) {
+        // Decode one character. Anything malformed becomes U+FFFD, which shows as '?'.
+        uint32_t unicode = *p++;
+        if(unicode >= 0x80) {
+            int extra = unicode >= 0xF8 ? -1 : unicode >= 0xF0 ? 3 : unicode >= 0xE0 ? 2 : unicode >= 0xC0 ? 1 : -1;
+            if(extra < 0) {
+                unicode = 0xFFFD;
+            } else {
+                unicode &= 0x3F >> extra;
+                while(extra--) {
+                    if((*p & 0xC0) != 0x80) {
+                        unicode = 0xFFFD;
+                        break;
+                    }
+                    unicode = unicode << 6 | (*p++ & 0x3F);
+                }
+            }
+        }
+        send_byte(utf8_code(unicode), LCD_CHARACTER, true);
+        cells++;
+    }
+    if(!Enable_Buffering) show();
+    return cells;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file LCD_VirtualScreen.cpp
+ * @author Keith Standiford
+ * @brief A virtual screen larger than the display, with a movable viewport
+ * @version 1.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2022 Keith Standiford. All rights reserved. 
+ * 
+ */
+
+#ifdef ARDUINO
+#include "LCD_VirtualScreen.h"
+#else
+#include <LCD_VirtualScreen.hpp>
+#endif
+
+
+LCD_VirtualScreen::LCD_VirtualScreen(LCD_I2C &lcd, char storage[], byte width, byte height) :
+    _lcd(lcd), _text(storage), _width(width), _height(height)
+{
+    if(_width > MAX_WIDTH) _width = MAX_WIDTH;
+    if(_text == NULL) _width = _height = 0;
+    _hardware = _lcd.rows() <= 2;
+    clear();
+    memset(_shown, ' ', sizeof(_shown));
+}
+
+void LCD_VirtualScreen::begin(bool Enable_Buffering)
+{
+    _lcd.clear();       // blank display RAM, and no shift
+    memset(_shown, ' ', sizeof(_shown));
+    _shift = 0;
+    _top = _left = 0;
+    refresh(Enable_Buffering);
+}
+
+void LCD_VirtualScreen::clear(void)
+{
+    if(_text != NULL) memset(_text, ' ', _width * _height);
+}
+
+void LCD_VirtualScreen::write(byte line, byte position, const char text[])
+{
+    if(text == NULL || line >= _height) return;
+    char *p = &_text[line * _width];
+    while(*text && position < _width) p[position++] = *text++;
+}
+
+void LCD_VirtualScreen::writeChar(byte line, byte position, char c)
+{
+    if(line < _height && position < _width) _text[line * _width + position] = c;
+}
+
+char LCD_VirtualScreen::charAt(byte line, byte position) const
+{
+    if(line < _height && position < _width) return _text[line * _width + position];
+    return ' ';
+}
+
+void LCD_VirtualScreen::setViewport(byte top, byte left)
+{
+    byte rows = _lcd.rows();
+    byte columns = _lcd.columns();
+
+    _top = _height > rows ? (top > _height - rows ? _height - rows : top) : 0;
+    _left = _width > columns ? (left > _width - columns ? _width - columns : left) : 0;
+}
+
+int LCD_VirtualScreen::refresh(bool Enable_Buffering)
+{
+    byte columns = _lcd.columns();
+    byte data[MAX_WIDTH];
+    int sent = 0;
+
+    if(_hardware && _shift != _left) {
+        // Pan with the display shift, whichever way round the display RAM line is shorter
+        int distance = ((int) _left - _shift + MAX_WIDTH) % MAX_WIDTH;
+        if(distance <= MAX_WIDTH / 2) {
+            while(distance--) _lcd.scrollDisplayLeft(true);
+        } else {
+            for(distance = MAX_WIDTH - distance; distance; distance--) _lcd.scrollDisplayRight(true);
+        }
+        _shift = _left;
+    }
+
+    for(byte row = 0; row < _lcd.rows(); row++) {
+        // the viewport line, blank below the bottom of the virtual screen
+        byte line = _top + row;
+        for(byte i = 0; i < columns; i++) data[i] = charAt(line, _left + i);
+        if(_hardware) {
+            // With the display shift, virtual position n lives at display RAM position n
+            sent += _lcd.writeChanges(row, _left, data, &_shown[row][_left], columns, true);
+        } else {
+            sent += _lcd.writeChanges(row, 0, data, _shown[row], columns, true);
+        }
+    }
+    if(!Enable_Buffering) _lcd.show();
+    return sent;
+}
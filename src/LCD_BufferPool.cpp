@@ -0,0 +1,62 @@
+/**
+ * @file LCD_BufferPool.cpp
+ * @author Keith Standiford
+ * @brief A pool of output buffers shared by several displays
+ * @version 1.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2022 Keith Standiford. All rights reserved. 
+ * 
+ */
+
+#include <LCD_BufferPool.hpp>
+
+
+LCD_BufferPool::LCD_BufferPool(byte storage[], size_t size) :
+    _storage(storage)
+{
+    size_t count = storage == NULL ? 0 : size / LCD_I2C::OUTPUT_BUFFER_LENGTH;
+    _count = count > MAX_BUFFERS ? MAX_BUFFERS : count;
+    _free = _count == 32 ? ~0u : (1u << _count) - 1;
+    _lowWater = _count;
+    _spinLockNum = spin_lock_claim_unused(true);
+    _spinLock = spin_lock_instance(_spinLockNum);
+}
+
+LCD_BufferPool::~LCD_BufferPool()
+{
+    spin_lock_unclaim(_spinLockNum);
+}
+
+LCD_BufferPool::byte *LCD_BufferPool::take(void)
+{
+    byte *buffer = nullptr;
+    uint32_t saved_irq = spin_lock_blocking(_spinLock);
+
+    if(_free) {
+        byte n = __builtin_ctz(_free);
+        _free &= ~(1u << n);
+        buffer = &_storage[n * LCD_I2C::OUTPUT_BUFFER_LENGTH];
+        byte left = __builtin_popcount(_free);
+        if(left < _lowWater) _lowWater = left;
+    } else {
+        _misses++;
+    }
+    spin_unlock(_spinLock, saved_irq);
+    return buffer;
+}
+
+void LCD_BufferPool::give(byte *buffer)
+{
+    size_t n = (buffer - _storage) / LCD_I2C::OUTPUT_BUFFER_LENGTH;
+
+    if(buffer < _storage || n >= _count) return;     // not one of ours
+    uint32_t saved_irq = spin_lock_blocking(_spinLock);
+    _free |= 1u << n;
+    spin_unlock(_spinLock, saved_irq);
+}
+
+LCD_BufferPool::byte LCD_BufferPool::available(void) const
+{
+    return __builtin_popcount(_free);
+}
@@ -0,0 +1,181 @@
+/**
+ * @file LCD_FrameBuffer.cpp
+ * @author Keith Standiford
+ * @brief A screen image shared by both cores, protected by sequence locks
+ * @version 1.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2022 Keith Standiford. All rights reserved. 
+ * 
+ */
+
+#include <hardware/timer.h>
+#include <LCD_FrameBuffer.hpp>
+
+
+LCD_FrameBuffer::LCD_FrameBuffer(LCD_I2C &lcd) :
+    _lcd(lcd)
+{
+    _rows = _lcd.rows() > MAX_LINES ? MAX_LINES : _lcd.rows();
+    _columns = _lcd.columns() > MAX_WIDTH ? MAX_WIDTH : _lcd.columns();
+    _spinLockNum = spin_lock_claim_unused(true);
+    _spinLock = spin_lock_instance(_spinLockNum);
+    for(byte i = 0; i < MAX_LINES; i++) memset(_lines[i].text, ' ', MAX_WIDTH);
+    memset(_shown, ' ', sizeof(_shown));
+    redraw();
+}
+
+LCD_FrameBuffer::~LCD_FrameBuffer()
+{
+    spin_lock_unclaim(_spinLockNum);
+}
+
+uint32_t LCD_FrameBuffer::begin_write(Line &line)
+{
+    uint32_t saved_irq = spin_lock_blocking(_spinLock);    // only against other writers
+    uint32_t seq = line.seq.load(std::memory_order_relaxed);
+
+    // If the flusher has sent everything up to now, start a new dirty bitmap
+    if(line.flushed.load() == seq) line.dirty = 0;
+    line.seq.store(seq + 1, std::memory_order_relaxed);    // odd: being written
+    std::atomic_thread_fence(std::memory_order_release);
+    return saved_irq;
+}
+
+void LCD_FrameBuffer::end_write(Line &line, uint32_t saved_irq)
+{
+    line.seq.store(line.seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    spin_unlock(_spinLock, saved_irq);
+}
+
+void LCD_FrameBuffer::write(byte line, byte position, const byte data[], byte length)
+{
+    if(line >= _rows || position >= _columns || data == NULL) return;
+    if(length > _columns - position) length = _columns - position;
+    if(length == 0) return;
+
+    Line &l = _lines[line];
+    uint32_t cells = ((length < 32 ? (1u << length) : 0u) - 1u) << position;
+    uint32_t saved_irq = begin_write(l);
+    memcpy(&l.text[position], data, length);
+    if(l.dirty & cells) _dropped = _dropped + 1;   // over cells which have not been sent yet
+    l.dirty |= cells;
+    end_write(l, saved_irq);
+}
+
+void LCD_FrameBuffer::write(byte line, byte position, const char text[])
+{
+    if(text != NULL) write(line, position, (const byte *) text, strnlen(text, MAX_WIDTH));
+}
+
+void LCD_FrameBuffer::writeChar(byte line, byte position, byte c)
+{
+    write(line, position, &c, 1);
+}
+
+void LCD_FrameBuffer::fill(byte line, byte position, byte c, byte count)
+{
+    byte data[MAX_WIDTH];
+
+    if(count > MAX_WIDTH) count = MAX_WIDTH;
+    memset(data, c, count);
+    write(line, position, data, count);
+}
+
+void LCD_FrameBuffer::clear(void)
+{
+    for(byte line = 0; line < _rows; line++) fill(line, 0, ' ', _columns);
+}
+
+void LCD_FrameBuffer::redraw(void)
+{
+    for(byte row = 0; row < MAX_LINES; row++) _stale[row] = true;
+}
+
+int LCD_FrameBuffer::flush(bool Enable_Buffering)
+{
+    int sent = flush_lines(SIZE_MAX);
+    if(!Enable_Buffering) _lcd.show();
+    return sent;
+}
+
+void LCD_FrameBuffer::setFrameRate(uint16_t frames_per_second, size_t max_bytes_per_frame)
+{
+    _framePeriod = frames_per_second ? 1000000u / frames_per_second : 0;
+    _frameBytes = max_bytes_per_frame ? max_bytes_per_frame : SIZE_MAX;
+    _nextFrame = time_us_32();
+}
+
+int LCD_FrameBuffer::frame(bool Enable_Buffering)
+{
+    uint32_t now = time_us_32();
+
+    if((int32_t) (now - _nextFrame) < 0) return 0;     // not time yet
+    _nextFrame += _framePeriod;
+    if((int32_t) (now - _nextFrame) >= 0) _nextFrame = now + _framePeriod;    // fell behind, so don't catch up
+    _frames++;
+
+    int sent = flush_lines(_frameBytes);
+    if(!Enable_Buffering) _lcd.show();
+    return sent;
+}
+
+int LCD_FrameBuffer::flush_lines(size_t max_bytes)
+{
+    byte text[MAX_WIDTH];
+    int sent = 0;
+    size_t bytes = 0;
+    byte start = _nextRow;
+
+    // Start where the last flush left off, so a byte limit can't starve the lower lines
+    for(byte n = 0; n < _rows; n++) {
+        byte row = (start + n) % _rows;
+        Line &l = _lines[row];
+        uint32_t seq = l.seq.load(std::memory_order_acquire);
+        uint32_t flushed = l.flushed.load(std::memory_order_relaxed);
+
+        if(seq == flushed && !_stale[row]) continue;   // nothing new
+        if(seq & 1) {                   // a writer is busy with it
+            _retries++;
+            continue;
+        }
+        uint32_t dirty = l.dirty;
+        memcpy(text, l.text, _columns);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(l.seq.load(std::memory_order_relaxed) != seq) {   // it changed under us
+            _retries++;
+            continue;
+        }
+
+        byte first = 0;
+        byte last = _columns - 1;
+        if(!_stale[row]) {    // only look at the dirty cells
+            if(dirty == 0) dirty = ~0u;
+            while(!(dirty & (1u << first))) first++;
+            while(!(dirty & (1u << last))) last--;
+        }
+
+        // Estimate the bytes: 4 per character, and 5 for the address of each run
+        size_t cost = 0;
+        bool run = false;
+        for(byte i = first; i <= last; i++) {
+            bool differs = _stale[row] || text[i] != _shown[row][i];
+            if(differs) cost += run ? 4 : 9;
+            run = differs;
+        }
+        if(bytes > 0 && bytes + cost > max_bytes) {     // leave it for the next frame
+            _nextRow = row;
+            break;
+        }
+        bytes += cost;
+
+        if(_stale[row]) {   // the display doesn't match _shown, so make every cell differ
+            for(byte i = 0; i < _columns; i++) _shown[row][i] = ~text[i];
+            _stale[row] = false;
+        }
+        sent += _lcd.writeChanges(row, first, &text[first], &_shown[row][first], last - first + 1, true);
+        l.flushed.store(seq);           // writers may now start a new dirty bitmap
+        _nextRow = (row + 1) % _rows;
+    }
+    return sent;
+}
@@ -8,9 +8,10 @@
  * @copyright Copyright (c) 2022 Keith Standiford. All rights reserved.
  * 
  * These are the wrappers to allow the Fast LCD I2C driver (which is written in C++)
- * to be used from a C program. The interface is simplified, and the buffering commands are
- * not available since C does not allow optional arguments. None the less, this allows 
- * users who have not made the transition to C++ to still enjoy substantial speed improvements 
+ * to be used from a C program. The simple interface drives one display and sends every call
+ * immediately. The handle interface (lcdh_ functions) drives any number of displays kept in 
+ * caller provided storage, with no heap, and can buffer output like the C++ version. Either way,
+ * users who have not made the transition to C++ still enjoy substantial speed improvements 
  * over most other drivers.
  * 
  * Use of the C++ version is encouraged.
@@ -18,13 +19,29 @@
 
 // Includes for Pi Pico
 #include <string.h>
+#include <new>
 #include <LCD_I2C-C.h>
 #include <LCD_I2C.hpp>
 
+static_assert(sizeof(LCD_I2C) <= sizeof(lcd_storage_t), 
+        "lcd_storage_t is too small for LCD_I2C. Define a larger LCD_I2C_STORAGE_SIZE.");
+static_assert(alignof(LCD_I2C) <= alignof(lcd_storage_t), "lcd_storage_t is not aligned for LCD_I2C");
 
-//  hidden pointer to LCD_I2C instance
 
-LCD_I2C* lcd = NULL;
+//  handles are simply pointers to the LCD_I2C object in the storage
+
+static inline LCD_I2C *object(lcd_handle_t h) noexcept {
+    return reinterpret_cast<LCD_I2C *>(h);
+}
+
+static inline lcd_handle_t handle(LCD_I2C *lcd) noexcept {
+    return reinterpret_cast<lcd_handle_t>(lcd);
+}
+
+//  hidden display for the simple functions, in static storage
+
+static lcd_storage_t lcd_storage;
+static LCD_I2C* lcd = NULL;
 
 #define Default_Addr  0x27
 #define MAX_CHARS 20
@@ -35,9 +52,10 @@ LCD_I2C* lcd = NULL;
 A helper to test if we have been initialized. If not, initialize anyway with default parameters.
 */
 
-void nullCheck()   noexcept {
-    if(lcd != NULL) return;
-    lcd = new LCD_I2C(Default_Addr, MAX_CHARS, MAX_LINES, PICO_DEFAULT_I2C_INSTANCE);
+static inline LCD_I2C *nullCheck()   noexcept {
+    if(lcd == NULL) 
+        lcd = new (&lcd_storage) LCD_I2C(Default_Addr, MAX_CHARS, MAX_LINES, PICO_DEFAULT_I2C_INSTANCE);
+    return lcd;
 }
 
 
@@ -47,145 +65,264 @@ void nullCheck()   noexcept {
 
 void lcd_init(byte address, byte columns, byte rows, i2c_inst * I2C)   noexcept {
 
-    if(lcd != NULL) {
-        lcd->show();    // be nice and dump the buffer
-        sleep_us(2000); // wait for display to be idle for sure...
-        delete lcd;
-    }
+    if(lcd != NULL) lcd_destroy(handle(lcd));
     // create a new instance which will also init the display.
-    lcd = new LCD_I2C(address, columns, rows, I2C); 
+    lcd = object(lcd_create(&lcd_storage, address, columns, rows, I2C)); 
     
 }
 
+// Handle interface
+
+lcd_handle_t lcd_create(lcd_storage_t *storage, byte address, byte columns, byte rows, i2c_inst_t *I2C)  noexcept
+{
+    return handle(new (storage) LCD_I2C(address, columns, rows, I2C));
+}
+
+void lcd_destroy(lcd_handle_t h)  noexcept
+{
+    LCD_I2C *display = object(h);
+    display->show();    // be nice and dump the buffer
+    sleep_us(2000);     // wait for display to be idle for sure...
+    display->~LCD_I2C();
+    if(display == lcd) lcd = NULL;
+}
+
+lcd_handle_t lcd_default(void)  noexcept
+{
+    return handle(nullCheck());
+}
+
+int lcd_show(lcd_handle_t h)  noexcept
+{
+    return object(h)->show();
+}
+
+size_t lcd_backlog(lcd_handle_t h)  noexcept
+{
+    return object(h)->backlog();
+}
+
+void lcdh_writeChar(lcd_handle_t h, byte c, bool buffered)  noexcept
+{
+    object(h)->writeChar(c, buffered);
+}
+
+void lcdh_writeString(lcd_handle_t h, const char s[], bool buffered)  noexcept
+{
+    object(h)->writeString(s, buffered);
+}
+
+void lcdh_writeBuffer(lcd_handle_t h, const uint8_t buffer[], size_t size, bool buffered)  noexcept
+{
+    object(h)->write(buffer, size, buffered);
+}
+
+void lcdh_setCursor(lcd_handle_t h, byte line, byte position, bool buffered)  noexcept
+{
+    object(h)->setCursor(line, position, buffered);
+}
+
+void lcdh_scrollDisplayLeft(lcd_handle_t h, bool buffered)  noexcept
+{
+    object(h)->scrollDisplayLeft(buffered);
+}
+
+void lcdh_scrollDisplayRight(lcd_handle_t h, bool buffered)  noexcept
+{
+    object(h)->scrollDisplayRight(buffered);
+}
+
+int lcdh_updateChar(lcd_handle_t h, byte charnum, const byte char_map[], bool buffered)  noexcept
+{
+    return object(h)->updateChar(charnum, char_map, buffered);
+}
+
+void lcdh_createChar(lcd_handle_t h, byte charnum, const byte char_map[])  noexcept
+{
+    object(h)->createChar(charnum, char_map);
+}
+
+void lcdh_clear(lcd_handle_t h)  noexcept
+{
+    object(h)->clear();
+}
+
+void lcdh_home(lcd_handle_t h)  noexcept
+{
+    object(h)->home();
+}
+
+void lcdh_backlight(lcd_handle_t h)  noexcept
+{
+    object(h)->backlight();
+}
+
+void lcdh_noBacklight(lcd_handle_t h)  noexcept
+{
+    object(h)->noBacklight();
+}
+
+void lcdh_display(lcd_handle_t h)  noexcept
+{
+    object(h)->display();
+}
+
+void lcdh_noDisplay(lcd_handle_t h)  noexcept
+{
+    object(h)->noDisplay();
+}
+
+void lcdh_cursor(lcd_handle_t h)  noexcept
+{
+    object(h)->cursor();
+}
+
+void lcdh_noCursor(lcd_handle_t h)  noexcept
+{
+    object(h)->noCursor();
+}
 
+void lcdh_blink(lcd_handle_t h)  noexcept
+{
+    object(h)->blink();
+}
+
+void lcdh_noBlink(lcd_handle_t h)  noexcept
+{
+    object(h)->noBlink();
+}
+
+void lcdh_autoscroll(lcd_handle_t h)  noexcept
+{
+    object(h)->autoscroll();
+}
+
+void lcdh_noAutoscroll(lcd_handle_t h)  noexcept
+{
+    object(h)->noAutoscroll();
+}
+
+void lcdh_leftToRight(lcd_handle_t h)  noexcept
+{
+    object(h)->leftToRight();
+}
+
+void lcdh_rightToLeft(lcd_handle_t h)  noexcept
+{
+    object(h)->rightToLeft();
+}
+
+
+// Simple interface, using the hidden display
 
 void lcd_clear(void)  noexcept
 {
-    nullCheck();
-    lcd->clear();
+    nullCheck()->clear();
 }
 
 void lcd_home(void)  noexcept
 {
-    nullCheck();
-    lcd->home();
+    nullCheck()->home();
 }
 
 // go to location on LCD
 void lcd_setCursor(byte line, byte position)  noexcept
 {
-    nullCheck();
-    lcd->setCursor( line,  position);
+    nullCheck()->setCursor( line,  position);
 }
 
 
 void lcd_writeString(const char s[])  noexcept
 {
-    nullCheck();
-    lcd->writeString(s);
+    nullCheck()->writeString(s);
 }
 
 void lcd_writeChar(byte c)  noexcept
 {
-    nullCheck();
-    lcd->writeChar(c);
+    nullCheck()->writeChar(c);
 }
 
 void lcd_writeBuffer(const uint8_t buffer[], size_t size)  noexcept
 {
-    nullCheck();
-    lcd->write(buffer, size);
+    nullCheck()->write(buffer, size);
 }
 
-
 void lcd_backlight(void)  noexcept
 {
-    nullCheck();
-    lcd->backlight();
+    nullCheck()->backlight();
 }
 
-void lcd_noBacklight()  noexcept
+void lcd_noBacklight(void)  noexcept
 {
-    nullCheck();
-    lcd->noBacklight();
+    nullCheck()->noBacklight();
 }
 
 void lcd_cursor(void)  noexcept
 {
-    nullCheck();
-    lcd->cursor();
+    nullCheck()->cursor();
 }
 
 void lcd_noCursor(void)  noexcept
 {
-    nullCheck();
-    lcd->noCursor();
+    nullCheck()->noCursor();
 }
 
 void lcd_blink(void)  noexcept
 {
-    nullCheck();
-    lcd->blink();
+    nullCheck()->blink();
 }
 
 void lcd_noBlink(void)  noexcept
 {
-    nullCheck();
-    lcd->noBlink();
+    nullCheck()->noBlink();
 }
 
 void lcd_display(void)  noexcept
 {
-    nullCheck();
-    lcd->display();
+    nullCheck()->display();
 }
 
 void lcd_noDisplay(void)  noexcept
 {
-    nullCheck();
-    lcd->noDisplay();
+    nullCheck()->noDisplay();
 }
 
 void lcd_scrollDisplayLeft(void)  noexcept
 {
-    nullCheck();
-    lcd->scrollDisplayLeft();
+    nullCheck()->scrollDisplayLeft();
 }
 
 void lcd_scrollDisplayRight(void)  noexcept
 {
-    nullCheck();
-    lcd->scrollDisplayRight();
+    nullCheck()->scrollDisplayRight();
 }
 
 void lcd_autoscroll(void)  noexcept
 {
-    nullCheck();
-    lcd->autoscroll();
+    nullCheck()->autoscroll();
 }
 
 void lcd_noAutoscroll(void)  noexcept
 {
-    nullCheck();
-    lcd->noAutoscroll();
+    nullCheck()->noAutoscroll();
 }
 
 void lcd_rightToLeft(void)  noexcept
 {
-    nullCheck();
-    lcd->rightToLeft();
+    nullCheck()->rightToLeft();
 }
 
 void lcd_leftToRight(void)  noexcept
 {
-    nullCheck();
-    lcd->leftToRight();
+    nullCheck()->leftToRight();
 }
 
 void lcd_createChar(byte charnum, const byte char_map[])  noexcept
 {
-    nullCheck();
-    lcd->createChar(charnum, char_map);
+    nullCheck()->createChar(charnum, char_map);
 }
 
-
+int lcd_updateChar(byte charnum, const byte char_map[])  noexcept
+{
+    return nullCheck()->updateChar(charnum, char_map);
+}
@@ -0,0 +1,104 @@
+/**
+ * @file LCD_Layers.cpp
+ * @author Keith Standiford
+ * @brief A base screen with pop-up layers over it
+ * @version 1.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2022 Keith Standiford. All rights reserved. 
+ * 
+ */
+
+#ifdef ARDUINO
+#include "LCD_Layers.h"
+#else
+#include <LCD_Layers.hpp>
+#endif
+
+
+LCD_Layers::LCD_Layers(LCD_I2C &lcd) : _lcd(lcd)
+{
+    _rows = _lcd.rows() < MAX_LINES ? _lcd.rows() : MAX_LINES;
+    _columns = _lcd.columns() < MAX_CHARS ? _lcd.columns() : MAX_CHARS;
+    clear();
+    memset(_shown, ' ', sizeof(_shown));
+}
+
+void LCD_Layers::write(byte line, byte position, const char text[])
+{
+    if(text == NULL || line >= _rows) return;
+    while(*text && position < _columns) _base[line][position++] = *text++;
+}
+
+void LCD_Layers::writeChar(byte line, byte position, char c)
+{
+    if(line < _rows && position < _columns) _base[line][position] = c;
+}
+
+void LCD_Layers::clear(void)
+{
+    memset(_base, ' ', sizeof(_base));
+}
+
+bool LCD_Layers::push(byte line, byte position, byte width, byte height, char storage[])
+{
+    if(_count >= MAX_POPUPS || storage == NULL) return false;
+    Popup &p = _popup[_count++];
+    p.line = line;
+    p.position = position;
+    p.width = width;
+    p.height = height;
+    p.text = storage;
+    memset(storage, ' ', width * height);
+    return true;
+}
+
+void LCD_Layers::pop(void)
+{
+    if(_count) _count--;
+}
+
+void LCD_Layers::writePopup(byte line, byte position, const char text[])
+{
+    if(_count == 0 || text == NULL) return;
+    Popup &p = _popup[_count - 1];
+    if(line >= p.height) return;
+    char *row = &p.text[line * p.width];
+    while(*text && position < p.width) row[position++] = *text++;
+}
+
+void LCD_Layers::compose(byte line, byte data[]) const
+{
+    memcpy(data, _base[line], _columns);
+    // Paint the pop-ups over the base from the bottom up, so the top one wins
+    for(byte n = 0; n < _count; n++) {
+        const Popup &p = _popup[n];
+        if(line < p.line || line >= p.line + p.height || p.position >= _columns) continue;
+        byte width = p.width < _columns - p.position ? p.width : _columns - p.position;
+        memcpy(&data[p.position], &p.text[(line - p.line) * p.width], width);
+    }
+}
+
+int LCD_Layers::refresh(bool Enable_Buffering)
+{
+    byte data[MAX_CHARS];
+    int sent = 0;
+
+    for(byte line = 0; line < _rows; line++) {
+        compose(line, data);
+        sent += _lcd.writeChanges(line, 0, data, _shown[line], _columns, true);
+    }
+    if(!Enable_Buffering) _lcd.show();
+    return sent;
+}
+
+int LCD_Layers::redraw(bool Enable_Buffering)
+{
+    byte data[MAX_CHARS];
+
+    for(byte line = 0; line < _rows; line++) {     // make every cell look changed
+        compose(line, data);
+        for(byte i = 0; i < _columns; i++) _shown[line][i] = ~data[i];
+    }
+    return refresh(Enable_Buffering);
+}
@@ -0,0 +1,179 @@
+/**
+ * @file LCD_Service.cpp
+ * @author Keith Standiford
+ * @brief Drive the display from the second core of the Pi Pico through a command queue
+ * @version 1.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2022 Keith Standiford. All rights reserved. 
+ * 
+ */
+
+#include <LCD_Service.hpp>
+
+
+LCD_Service::LCD_Service(LCD_I2C &lcd, byte queue[], size_t size) :
+    _lcd(lcd), _queue(queue)
+{
+    // Use the largest power of 2 which fits, so indices can just be masked
+    uint32_t capacity = 1;
+    while(capacity * 2 <= size) capacity *= 2;
+    _mask = capacity - 1;
+    if(size == 0) _queue = nullptr;     // no queue at all, so every command is dropped
+}
+
+bool LCD_Service::put(byte op, byte arg_count, byte arg0, byte arg1, const byte *data, size_t length)
+{
+    uint32_t head = _head.load(std::memory_order_relaxed);
+    uint32_t used = head - _tail.load(std::memory_order_acquire);
+    size_t size = 1 + arg_count + length;
+
+    if(size > capacity() - used) {  // it doesn't fit, so drop the whole command
+        _dropped = _dropped + 1;
+        return false;
+    }
+    _queue[head++ & _mask] = op;
+    if(arg_count > 0) _queue[head++ & _mask] = arg0;
+    if(arg_count > 1) _queue[head++ & _mask] = arg1;
+    if(length) {
+        size_t first = _mask + 1 - (head & _mask);  // room before the end of the ring
+        if(first > length) first = length;
+        memcpy(&_queue[head & _mask], data, first);
+        memcpy(_queue, data + first, length - first);
+        head += length;
+    }
+    _head.store(head, std::memory_order_release);   // publish the whole command at once
+    if(used + size > _highWater) _highWater = used + size;
+    __sev();                                        // wake the consumer
+    return true;
+}
+
+void LCD_Service::get(uint32_t index, byte *dest, size_t length) const
+{
+    size_t first = _mask + 1 - (index & _mask);
+    if(first > length) first = length;
+    memcpy(dest, &_queue[index & _mask], first);
+    memcpy(dest + first, _queue, length - first);
+}
+
+bool LCD_Service::clear(void)
+{ return put(OP_CLEAR, 0); }
+
+bool LCD_Service::home(void)
+{ return put(OP_HOME, 0); }
+
+bool LCD_Service::setCursor(byte line, byte position)
+{ return put(OP_SET_CURSOR, 2, line, position); }
+
+bool LCD_Service::setAddress(byte line, byte position)
+{ return put(OP_SET_ADDRESS, 2, line, position); }
+
+bool LCD_Service::writeString(const char s[])
+{
+    if(s == NULL) return true;
+    return write((const byte *) s, strlen(s));
+}
+
+bool LCD_Service::writeChar(byte c)
+{ return put(OP_TEXT, 1, 1, 0, &c, 1); }
+
+bool LCD_Service::write(const byte buffer[], size_t size)
+{
+    bool queued = true;
+
+    if(buffer == NULL) return true;
+    while(size) {
+        size_t length = size > MAX_TEXT ? MAX_TEXT : size;
+        queued &= put(OP_TEXT, 1, length, 0, buffer, length);
+        buffer += length;
+        size -= length;
+    }
+    return queued;
+}
+
+bool LCD_Service::createChar(byte charnum, const byte char_map[])
+{ return put(OP_CREATE_CHAR, 1, charnum, 0, char_map, LCD_I2C::CUSTOM_SYMBOL_SIZE); }
+
+bool LCD_Service::backlight(void)
+{ return put(OP_BACKLIGHT, 0); }
+
+bool LCD_Service::noBacklight(void)
+{ return put(OP_NO_BACKLIGHT, 0); }
+
+bool LCD_Service::display(void)
+{ return put(OP_DISPLAY, 0); }
+
+bool LCD_Service::noDisplay(void)
+{ return put(OP_NO_DISPLAY, 0); }
+
+bool LCD_Service::cursor(void)
+{ return put(OP_CURSOR, 0); }
+
+bool LCD_Service::noCursor(void)
+{ return put(OP_NO_CURSOR, 0); }
+
+bool LCD_Service::blink(void)
+{ return put(OP_BLINK, 0); }
+
+bool LCD_Service::noBlink(void)
+{ return put(OP_NO_BLINK, 0); }
+
+bool LCD_Service::scrollDisplayLeft(void)
+{ return put(OP_SCROLL_LEFT, 0); }
+
+bool LCD_Service::scrollDisplayRight(void)
+{ return put(OP_SCROLL_RIGHT, 0); }
+
+int LCD_Service::service(int max_commands)
+{
+    int done = 0;
+    byte data[MAX_TEXT];
+    uint32_t tail = _tail.load(std::memory_order_relaxed);
+    uint32_t head = _head.load(std::memory_order_acquire);
+
+    while(tail != head && (max_commands == 0 || done < max_commands)) {
+        byte op = at(tail++);
+        byte length;
+
+        switch(op) {
+            case OP_CLEAR:          _lcd.clear(); break;
+            case OP_HOME:           _lcd.home(); break;
+            case OP_SET_CURSOR:     _lcd.setCursor(at(tail), at(tail+1), true); tail += 2; break;
+            case OP_SET_ADDRESS:    _lcd.setAddress(at(tail), at(tail+1), true); tail += 2; break;
+            case OP_TEXT:
+                length = at(tail++);
+                get(tail, data, length);
+                _lcd.write(data, length, true);
+                tail += length;
+                break;
+            case OP_CREATE_CHAR:
+                length = at(tail++);    // the character number
+                get(tail, data, LCD_I2C::CUSTOM_SYMBOL_SIZE);
+                _lcd.createChar(length, data);
+                tail += LCD_I2C::CUSTOM_SYMBOL_SIZE;
+                break;
+            case OP_BACKLIGHT:      _lcd.backlight(); break;
+            case OP_NO_BACKLIGHT:   _lcd.noBacklight(); break;
+            case OP_DISPLAY:        _lcd.display(); break;
+            case OP_NO_DISPLAY:     _lcd.noDisplay(); break;
+            case OP_CURSOR:         _lcd.cursor(); break;
+            case OP_NO_CURSOR:      _lcd.noCursor(); break;
+            case OP_BLINK:          _lcd.blink(); break;
+            case OP_NO_BLINK:       _lcd.noBlink(); break;
+            case OP_SCROLL_LEFT:    _lcd.scrollDisplayLeft(true); break;
+            case OP_SCROLL_RIGHT:   _lcd.scrollDisplayRight(true); break;
+        }
+        _tail.store(tail, std::memory_order_release);   // give the space back
+        done++;
+        if(tail == head) head = _head.load(std::memory_order_acquire);
+    }
+    if(tail == head) _lcd.show();   // caught up, so show what we have
+    return done;
+}
+
+void LCD_Service::run(void)
+{
+    while(true) {
+        if(service() == 0) __wfe();     // the producer's __sev() wakes us
+    }
+}
@@ -0,0 +1,152 @@
+/**
+ * @file LCD_UpdateQueue.cpp
+ * @author Keith Standiford
+ * @brief Lock-free display updates from many tasks and interrupt handlers
+ * @version 1.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2022 Keith Standiford. All rights reserved. 
+ * 
+ */
+
+#include <hardware/timer.h>
+#include <LCD_UpdateQueue.hpp>
+
+
+LCD_UpdateQueue::Field::Field(byte line, byte position, byte width, byte storage[],
+        byte priority, uint32_t max_age_us) :
+    _line(line), _position(position), _width(width), _posted(storage),
+    _priority(priority), _maxAge(max_age_us)
+{
+    if(_width > MAX_WIDTH) _width = MAX_WIDTH;
+    _shown = storage + _width;
+    memset(storage, ' ', 2 * _width);
+}
+
+void LCD_UpdateQueue::Field::post(const char text[])
+{
+    post((const byte *) text, text == NULL ? 0 : strnlen(text, _width));
+}
+
+void LCD_UpdateQueue::Field::post(const byte data[], byte length)
+{
+    if(data == NULL) length = 0;
+    if(length > _width) length = _width;
+
+    // The deadline runs from the oldest post not yet sent
+    if(!_pending.load(std::memory_order_relaxed)) _since = time_us_32();
+
+    // We are the only writer, so a plain load and store are enough
+    uint32_t seq = _seq.load(std::memory_order_relaxed);
+    _seq.store(seq + 1, std::memory_order_relaxed);     // odd: being written
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy(_posted, data, length);
+    memset(_posted + length, ' ', _width - length);
+    _seq.store(seq + 2);                                // even: complete
+
+    // Flag it after the text is complete (sequentially consistent, so that the
+    // consumer clearing the flag can not hide a post it has not read)
+    _pending.store(true);
+    if(_queue != nullptr) _queue->_pending.store(true);
+}
+
+LCD_UpdateQueue::LCD_UpdateQueue(LCD_I2C &lcd) :
+    _lcd(lcd)
+{
+}
+
+void LCD_UpdateQueue::attach(Field &field)
+{
+    field._queue = this;
+    field._next = _fields;
+    _fields = &field;
+    field._pending.store(true, std::memory_order_relaxed);
+    _pending.store(true, std::memory_order_relaxed);
+}
+
+void LCD_UpdateQueue::redraw(void)
+{
+    for(Field *field = _fields; field != nullptr; field = field->_next) {
+        field->_stale = true;
+        field->_pending.store(true, std::memory_order_relaxed);
+    }
+    _pending.store(true, std::memory_order_relaxed);
+}
+
+int LCD_UpdateQueue::service(bool Enable_Buffering)
+{
+    return schedule(SIZE_MAX, Enable_Buffering);
+}
+
+int LCD_UpdateQueue::schedule(size_t max_bytes, bool Enable_Buffering)
+{
+    byte text[MAX_WIDTH];
+    int sent = 0;
+    size_t bytes = 0;
+    uint32_t now = time_us_32();
+    uint32_t round = ++_round;          // marks the fields already looked at in this call
+
+    // Clear the flags *before* reading, so a post which lands after we read is not lost
+    if(_pending.load()) {
+        _pending.store(false);
+        while(true) {
+            // The most urgent pending field: highest priority, then earliest deadline
+            Field *field = nullptr;
+            int32_t slack = 0;
+            for(Field *f = _fields; f != nullptr; f = f->_next) {
+                if(f->_round == round || !f->_pending.load()) continue;
+                // No deadline still counts the wait, so the oldest goes first rather than starving
+                int32_t s = f->_since + (f->_maxAge ? f->_maxAge : NO_DEADLINE_US) - now;
+                if(field == nullptr || f->_priority > field->_priority ||
+                        (f->_priority == field->_priority && s < slack)) {
+                    field = f;
+                    slack = s;
+                }
+            }
+            if(field == nullptr) break;
+            field->_round = round;
+            field->_pending.store(false);
+
+            uint32_t seq = field->_seq.load();
+            memcpy(text, field->_posted, field->_width);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if((seq & 1) || seq != field->_seq.load(std::memory_order_relaxed)) {
+                // caught part way through a post, so leave it for next time
+                field->_pending.store(true, std::memory_order_relaxed);
+                _pending.store(true, std::memory_order_relaxed);
+                _retries++;
+                continue;
+            }
+
+            // Estimate the bytes: 4 per character, and 5 for the address of each run
+            size_t cost = 0;
+            bool run = false;
+            for(byte i = 0; i < field->_width; i++) {
+                bool differs = field->_stale || text[i] != field->_shown[i];
+                if(differs) cost += run ? 4 : 9;
+                run = differs;
+            }
+            if(bytes > 0 && bytes + cost > max_bytes) {    // no room in this slot
+                field->_pending.store(true, std::memory_order_relaxed);
+                _pending.store(true, std::memory_order_relaxed);
+                _deferred++;
+                continue;
+            }
+            bytes += cost;
+            if(field->_maxAge && slack < 0) _late++;
+
+            if(field->_stale) {
+                _lcd.setAddress(field->_line, field->_position, true);
+                _lcd.write(text, field->_width, true);
+                memcpy(field->_shown, text, field->_width);
+                field->_stale = false;
+                sent += field->_width;
+            } else {
+                sent += _lcd.writeChanges(field->_line, field->_position, text, field->_shown, field->_width, true);
+            }
+            _updates++;
+        }
+    }
+    if(!Enable_Buffering) _lcd.show();
+    return sent;
+}
@@ -0,0 +1,162 @@
+/**
+ * @file LCD_Async.hpp
+ * @author Keith Standiford
+ * @brief C++20 coroutine versions of the slow display operations
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022 Keith Standiford. All rights reserved.
+ * @remark Header only. Needs a C++20 compiler with coroutines; otherwise it is empty.
+ *
+ */
+#pragma once
+
+#include <LCD_I2C.hpp>
+
+#if defined(__cpp_impl_coroutine)
+#include <coroutine>
+
+/**
+ * @brief Awaitable versions of show(), clear(), home() and the display initialization,
+ * for use with your own coroutine scheduler.
+ *
+ * Instead of sleeping, each one suspends the calling coroutine until the display is ready,
+ * so other coroutines can run. flush() sends the buffer in small pieces, suspending
+ * between them.
+ *
+ * The Executor is yours. It needs just two member functions:
+ * @code
+ * uint64_t now();                                          // the time in microseconds
+ * void resumeAt(std::coroutine_handle<> h, uint64_t time); // call h.resume() at or after time
+ * @endcode
+ * On the Pi Pico, now() is usually time_us_64(). On a host, a simulated clock works just as well.
+ *
+ * @code
+ * LCD_I2C lcd(0x27, 20, 4, i2c0, false);   // don't wait for the display here
+ * LCD_Async<MyExecutor> async(lcd, executor);
+ * MyTask display_task() {
+ *     co_await async.init();
+ *     lcd.writeString("Hello", true);
+ *     co_await async.flush();
+ * }
+ * @endcode
+ *
+ * @note Await each operation before using the display again. The display ignores anything
+ * sent while it is busy with clear(), home() or initialization.
+ */
+template <class Executor>
+class LCD_Async {
+ public:
+
+    /**
+     * @brief The result of the operations. Await it from any coroutine.
+     *
+     * It does not start until it is awaited, and resumes the awaiting coroutine when it finishes.
+     */
+    class Task {
+     public:
+        /** @brief The coroutine promise */
+        struct promise_type {
+            std::coroutine_handle<> continuation = std::noop_coroutine();
+
+            Task get_return_object() noexcept
+            { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            struct FinalAwaiter {
+                bool await_ready() noexcept { return false; }
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept
+                { return h.promise().continuation; }
+                void await_resume() noexcept {}
+            };
+            FinalAwaiter final_suspend() noexcept { return {}; }
+            void return_void() noexcept {}
+            void unhandled_exception() noexcept {}
+        };
+
+        Task(Task &&other) noexcept : _handle(other._handle) { other._handle = nullptr; }
+        Task(const Task &) = delete;
+        Task &operator=(const Task &) = delete;
+        ~Task() { if(_handle) _handle.destroy(); }
+
+        bool await_ready() const noexcept { return !_handle || _handle.done(); }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+        {
+            _handle.promise().continuation = awaiting;
+            return _handle;
+        }
+        void await_resume() const noexcept {}
+
+     private:
+        explicit Task(std::coroutine_handle<promise_type> handle) noexcept : _handle(handle) {}
+        std::coroutine_handle<promise_type> _handle;
+    };
+
+    /**
+     * @brief Construct the coroutine interface for a display
+     *
+     * @param lcd The display
+     * @param executor The scheduler which resumes suspended coroutines
+     */
+    LCD_Async(LCD_I2C &lcd, Executor &executor) noexcept :
+        _lcd(lcd), _executor(executor) {}
+
+    /**
+     * @brief Transmit the buffer, suspending after every piece.
+     *
+     * @param chunk The most bytes to transmit before letting other coroutines run (at least 5)
+     */
+    Task flush(size_t chunk = 16) noexcept
+    {
+        while(_lcd.showSome(chunk) > 0 && _lcd.backlog() > 0)
+            co_await wait(0);
+    }
+
+    /**
+     * @brief Clear the display, suspending until it is ready again.
+     */
+    Task clear(void) noexcept
+    {
+        co_await flush();
+        co_await wait(_lcd.startClear());
+    }
+
+    /**
+     * @brief Home the display, suspending until it is ready again.
+     */
+    Task home(void) noexcept
+    {
+        co_await flush();
+        co_await wait(_lcd.startHome());
+    }
+
+    /**
+     * @brief Initialize the display, suspending through the waits between steps.
+     * Use with a display constructed with Initialize false.
+     */
+    Task init(void) noexcept
+    {
+        for(uint8_t step = 0; step < LCD_I2C::INIT_STEPS; step++)
+            co_await wait(_lcd.initStep(step));
+    }
+
+ private:
+
+    // Suspend for at least time_us. Zero just lets other coroutines run.
+    struct Wait {
+        Executor &executor;
+        uint64_t deadline;
+        bool yield;
+
+        bool await_ready() noexcept { return !yield && executor.now() >= deadline; }
+        void await_suspend(std::coroutine_handle<> h) noexcept { executor.resumeAt(h, deadline); }
+        void await_resume() noexcept {}
+    };
+
+    Wait wait(uint32_t time_us) noexcept
+    { return Wait{_executor, _executor.now() + time_us, time_us == 0}; }
+
+    LCD_I2C &_lcd;
+    Executor &_executor;
+};
+
+#endif
@@ -0,0 +1,152 @@
+/**
+ * @file LCD_BarGraph.hpp
+ * @author Keith Standiford
+ * @brief Bar graph and level meter widget for the Fast LCD I2C driver
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022 Keith Standiford. All rights reserved.
+ * @remark Compiles for Arduino or for Pi Pico
+ *
+ */
+#pragma once
+
+#ifdef ARDUINO
+#include "LCD_I2C.h"
+#else
+#include <string.h>
+#include <hardware/i2c.h>
+#include <LCD_I2C.hpp>
+#endif
+
+/**
+ * @brief A horizontal or vertical bar graph (level meter) with sub-character resolution.
+ *
+ * Each character cell of the bar is divided into 5 steps (horizontal bars, one per dot column)
+ * or 8 steps (vertical bars, one per dot row) using partially filled custom characters.
+ * The bar remembers what it last drew, so setLevel() only sends the cells at the moving
+ * edge of the bar. Moving a 20 character bar by one step usually costs a single character
+ * instead of the whole bar.
+ *
+ * The partial fill characters are loaded by loadGlyphs(). Any number of bars with the same
+ * orientation can share one set of glyphs. Horizontal bars need 4 custom characters
+ * and vertical bars need 7, so both orientations cannot be displayed at once. The full cell
+ * uses the display's built in solid block (character 0xFF) and the empty cell is a space.
+ *
+ * A horizontal bar occupies `length` cells to the right of (line, position) and fills from
+ * the left. A vertical bar occupies `length` cells from (line, position) downward and fills
+ * from the bottom.
+ *
+ * @note Line and position are in the *same* order on Arduino and Pi Pico.
+ */
+class LCD_BarGraph {
+ public:
+
+    using byte = uint8_t;
+
+    /** @brief The direction of the bar */
+    enum Orientation : byte {
+        HORIZONTAL,     ///< Fills from left to right, 5 steps per cell
+        VERTICAL        ///< Fills from bottom to top, 8 steps per cell
+    };
+
+    /** @brief The number of custom characters used by a horizontal bar */
+    static constexpr byte HORIZONTAL_GLYPHS = 4;
+    /** @brief The number of custom characters used by a vertical bar */
+    static constexpr byte VERTICAL_GLYPHS = 7;
+
+    /**
+     * @brief Construct a bar graph. Nothing is sent to the display.
+     *
+     * @param lcd The display to draw on
+     * @param line The row (or line) of the top left cell of the bar
+     * @param position The position (or column) of the top left cell of the bar
+     * @param length The length of the bar in character cells
+     * @param orientation HORIZONTAL or VERTICAL
+     * @param first_glyph The first custom character (0-7) of the glyph set to use. See loadGlyphs().
+     * It is moved down if the glyphs would run past custom character 7.
+     */
+    LCD_BarGraph(LCD_I2C &lcd, byte line, byte position, byte length,
+            Orientation orientation = HORIZONTAL, byte first_glyph = 0) noexcept;
+
+    /**
+     * @brief Load the partial fill custom characters for bars of one orientation.
+     *
+     * This only needs to be done once for all the bars sharing the same glyphs. Glyphs
+     * which are already loaded are not sent again, so calling it again is cheap.
+     *
+     * @param lcd The display to load
+     * @param orientation HORIZONTAL (4 characters) or VERTICAL (7 characters)
+     * @param first_glyph The first custom character (0-7) to use, moved down if the glyphs would not fit
+     */
+    static void loadGlyphs(LCD_I2C &lcd, Orientation orientation = HORIZONTAL, byte first_glyph = 0) noexcept;
+
+    /**
+     * @brief Load the partial fill custom characters used by this bar
+     */
+    inline void loadGlyphs(void) noexcept
+    { loadGlyphs(_lcd, _orientation, _firstGlyph); }
+
+    /**
+     * @brief The number of steps in a full bar (5 or 8 per cell)
+     */
+    inline uint16_t resolution(void) const noexcept
+    { return _length * (_orientation == HORIZONTAL ? 5 : 8); }
+
+    /**
+     * @brief The current level of the bar in steps
+     */
+    inline uint16_t level(void) const noexcept
+    { return _level; }
+
+    /**
+     * @brief Set the bar to a level. Only the cells which change are sent.
+     *
+     * @param level The level in steps, 0 to resolution()
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display.
+     */
+    void setLevel(uint16_t level, bool Enable_Buffering = false) noexcept;
+
+    /**
+     * @brief Set the bar to show a value in a range. Only the cells which change are sent.
+     *
+     * @param value The value to show. It is limited to the range.
+     * @param min The value shown as an empty bar
+     * @param max The value shown as a full bar
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display.
+     */
+    void setValue(int32_t value, int32_t min, int32_t max, bool Enable_Buffering = false) noexcept;
+
+    /**
+     * @brief Send every cell of the bar again, for example after the screen was cleared.
+     *
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display.
+     */
+    void redraw(bool Enable_Buffering = false) noexcept;
+
+ private:
+
+    static constexpr byte FULL_BLOCK = 0xFF;    // solid block in the character ROM
+    static constexpr byte EMPTY = ' ';
+
+    LCD_I2C &_lcd;
+    byte _line;
+    byte _position;
+    byte _length;
+    Orientation _orientation;
+    byte _firstGlyph;
+    uint16_t _level = 0;
+    bool _drawn = false;    // false until the whole bar has been sent once
+
+    // The character to display in cell i (counting from where the bar starts) for a level
+    byte cell(uint16_t level, byte i) const noexcept;
+
+    // Send cells first to last (inclusive) for a level
+    void drawCells(uint16_t level, byte first, byte last) noexcept;
+};
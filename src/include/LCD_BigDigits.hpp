@@ -0,0 +1,146 @@
+/**
+ * @file LCD_BigDigits.hpp
+ * @author Keith Standiford
+ * @brief Large digit readouts for the Fast LCD I2C driver
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022 Keith Standiford. All rights reserved.
+ * @remark Compiles for Arduino or for Pi Pico
+ *
+ */
+#pragma once
+
+#ifdef ARDUINO
+#include "LCD_I2C.h"
+#else
+#include <string.h>
+#include <hardware/i2c.h>
+#include <LCD_I2C.hpp>
+#endif
+
+/**
+ * @brief A readout of large digits, each drawn from several character cells.
+ *
+ * Three fonts are built in. Each one draws its digits from a set of custom character
+ * "segments" which is loaded once with loadGlyphs().
+ *  - FONT_2x2 digits are 2 cells wide and 2 lines high, using 8 custom characters.
+ *  - FONT_3x2 digits are 3 cells wide and 2 lines high, using 8 custom characters.
+ *  - FONT_3x4 digits are 3 cells wide and 4 lines high, using only 2 custom characters,
+ *    so it can share the display with other custom characters.
+ * 
+ * The readout remembers what it shows. When the number changes, only the digits
+ * which changed are touched, and within those only the cells which differ are sent.
+ * The digits 0-9, blank and minus can be displayed.
+ *
+ * @note Line and position are in the *same* order on Arduino and Pi Pico.
+ */
+class LCD_BigDigits {
+ public:
+
+    using byte = uint8_t;
+
+    /** @brief The built in fonts */
+    enum Font : byte {
+        FONT_2x2,   ///< 2 cells wide, 2 lines high
+        FONT_3x2,   ///< 3 cells wide, 2 lines high
+        FONT_3x4    ///< 3 cells wide, 4 lines high
+    };
+
+    /** @brief The largest number of digits in one readout */
+    static constexpr byte MAX_DIGITS = 10;
+
+    /**
+     * @brief Construct a readout. Nothing is sent to the display.
+     *
+     * The readout is moved up or cut down to fit the display. A font taller than the
+     * display (FONT_3x4 on a two line display) leaves it with no digits, so it draws nothing.
+     *
+     * @param lcd The display to draw on
+     * @param line The row (or line) of the top left cell of the readout
+     * @param position The position (or column) of the top left cell of the readout
+     * @param digits The number of digits in the readout
+     * @param font The font to use
+     * @param spacing The number of blank columns between digits
+     * @param first_glyph The first custom character (0-7) to use. Only FONT_3x4 leaves a choice.
+     */
+    LCD_BigDigits(LCD_I2C &lcd, byte line, byte position, byte digits, Font font = FONT_3x2,
+            byte spacing = 1, byte first_glyph = 0) noexcept;
+
+    /**
+     * @brief The number of custom characters used by a font
+     */
+    static byte glyphCount(Font font) noexcept;
+
+    /**
+     * @brief Load the segment custom characters for a font.
+     *
+     * This only needs to be done once for all readouts using the same font. Segments
+     * which are already loaded are not sent again, so calling it again is cheap.
+     *
+     * @param lcd The display to load
+     * @param font The font
+     * @param first_glyph The first custom character (0-7) to use. Only FONT_3x4 leaves a choice.
+     */
+    static void loadGlyphs(LCD_I2C &lcd, Font font, byte first_glyph = 0) noexcept;
+
+    /**
+     * @brief Load the segment custom characters used by this readout
+     */
+    inline void loadGlyphs(void) noexcept
+    { loadGlyphs(_lcd, _font, _firstGlyph); }
+
+    /**
+     * @brief Show a string of digits. Only the cells which change are sent.
+     *
+     * The characters '0'-'9', '-' and ' ' are displayed, anything else is shown as blank.
+     * The string fills the readout from the left, and any digits beyond its end are blanked.
+     *
+     * @param text The string to display
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display.
+     */
+    void setText(const char text[], bool Enable_Buffering = false) noexcept;
+
+    /**
+     * @brief Show a number, right justified. Only the cells which change are sent.
+     *
+     * If the number does not fit, the readout is filled with '-'.
+     *
+     * @param value The number to display
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display.
+     */
+    void setNumber(int32_t value, bool Enable_Buffering = false) noexcept;
+
+    /**
+     * @brief Send every cell of the readout again, for example after the screen was cleared.
+     *
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display.
+     */
+    void redraw(bool Enable_Buffering = false) noexcept;
+
+ private:
+
+    LCD_I2C &_lcd;
+    byte _line;
+    byte _position;
+    byte _digits;
+    Font _font;
+    byte _spacing;
+    byte _firstGlyph;
+    byte _width;                // of one digit, in cells
+    byte _height;               // of one digit, in lines
+    char _shown[MAX_DIGITS];    // the digits on the display
+    bool _drawn = false;        // false until the whole readout has been sent once
+
+    // Render one line of the readout for a string of digits
+    void renderLine(const char digits[], byte row, byte cells[]) const noexcept;
+
+    // Send the cells which differ between the digits shown and the new digits
+    void update(const char digits[], bool Enable_Buffering) noexcept;
+};
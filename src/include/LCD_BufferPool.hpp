@@ -0,0 +1,93 @@
+/**
+ * @file LCD_BufferPool.hpp
+ * @author Keith Standiford
+ * @brief A pool of output buffers shared by several displays
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022 Keith Standiford. All rights reserved.
+ * @remark Pi Pico only
+ *
+ */
+#pragma once
+
+#include <string.h>
+#include <hardware/i2c.h>
+#include <hardware/sync.h>
+#include <LCD_I2C.hpp>
+
+/**
+ * @brief A pool of output buffers which displays borrow while they have output waiting.
+ *
+ * Build with LCD_I2C_BUFFER_POOL defined as 1, create one pool with room for as many buffers
+ * as displays will be busy at once, and give it to LCD_I2C::setBufferPool() before
+ * constructing the displays. Each buffer is LCD_I2C::OUTPUT_BUFFER_LENGTH bytes.
+ *
+ * @code
+ * static uint8_t storage[2 * LCD_I2C::OUTPUT_BUFFER_LENGTH];
+ * static LCD_BufferPool pool(storage, sizeof(storage));
+ * LCD_I2C::setBufferPool(&pool);
+ * @endcode
+ *
+ * The pool is safe to use from both cores and from interrupt handlers.
+ */
+class LCD_BufferPool {
+ public:
+
+    using byte = uint8_t;
+
+    /** @brief The most buffers in a pool */
+    static constexpr byte MAX_BUFFERS = 32;
+
+    /**
+     * @brief Construct a pool of buffers.
+     *
+     * @param storage The storage for the buffers
+     * @param size The size of the storage. It holds size / LCD_I2C::OUTPUT_BUFFER_LENGTH buffers (at most 32).
+     */
+    LCD_BufferPool(byte storage[], size_t size) noexcept;
+
+    /**
+     * @brief Release the hardware spin lock
+     */
+    ~LCD_BufferPool();
+
+    /**
+     * @brief Borrow a buffer.
+     *
+     * @return (byte *) The buffer, or nullptr if none is free
+     */
+    byte *take(void) noexcept;
+
+    /**
+     * @brief Give back a borrowed buffer.
+     *
+     * @param buffer The buffer
+     */
+    void give(byte *buffer) noexcept;
+
+    /** @brief The number of buffers in the pool */
+    inline byte count(void) const noexcept
+    { return _count; }
+
+    /** @brief The number of buffers free now */
+    byte available(void) const noexcept;
+
+    /** @brief The fewest buffers which have been free at once */
+    inline byte lowWater(void) const noexcept
+    { return _lowWater; }
+
+    /** @brief The number of times a display found the pool empty */
+    inline uint32_t misses(void) const noexcept
+    { return _misses; }
+
+ private:
+
+    byte *_storage;
+    byte _count;
+    uint32_t _free;         // bit n is set when buffer n is free
+    byte _lowWater;
+    uint32_t _misses = 0;
+    uint _spinLockNum;
+    spin_lock_t *_spinLock;
+};
@@ -0,0 +1,179 @@
+/**
+ * @file LCD_Canvas.hpp
+ * @author Keith Standiford
+ * @brief A small pixel graphics window for the Fast LCD I2C driver
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022 Keith Standiford. All rights reserved.
+ * @remark Compiles for Arduino or for Pi Pico
+ *
+ */
+#pragma once
+
+#ifdef ARDUINO
+#include "LCD_I2C.h"
+#else
+#include <string.h>
+#include <hardware/i2c.h>
+#include <LCD_I2C.hpp>
+#endif
+
+/**
+ * @brief A pixel graphics window built from custom characters.
+ *
+ * The custom characters are placed side by side on the screen as tiles of a small
+ * bitmap, for example 4 cells by 2 lines giving 20 x 16 pixels. Drawing is done in a copy of
+ * the bitmap in RAM, and nothing is sent until commit(). Then only the rows of the
+ * custom characters which changed are uploaded (see LCD_I2C::updateChars()), and the tiles
+ * are placed on the screen the first time.
+ *
+ * Pixel 0,0 is the top left corner. Note that the display leaves a gap between character
+ * cells, so the picture has small gaps every 5 pixels across and every 8 pixels down.
+ * 
+ * This makes a scrolling trend graph (see push()) cheap enough to update at tens of Hz.
+ *
+ * @note Line and position are in the *same* order on Arduino and Pi Pico.
+ */
+class LCD_Canvas {
+ public:
+
+    using byte = uint8_t;
+
+    /** @brief The largest number of tiles (columns x rows) */
+    static constexpr byte MAX_TILES = 8;
+    /** @brief The width of one tile in pixels */
+    static constexpr byte TILE_WIDTH = 5;
+    /** @brief The height of one tile in pixels */
+    static constexpr byte TILE_HEIGHT = 8;
+
+    /**
+     * @brief Construct a canvas with a blank bitmap. Nothing is sent to the display.
+     *
+     * @param lcd The display to draw on
+     * @param line The row (or line) of the top left tile
+     * @param position The position (or column) of the top left tile
+     * @param columns The number of tiles across
+     * @param rows The number of tiles down
+     * @param first_glyph The first custom character (0-7) to use. 
+     * columns x rows characters are used from here on.
+     */
+    LCD_Canvas(LCD_I2C &lcd, byte line, byte position, byte columns, byte rows,
+            byte first_glyph = 0) noexcept;
+
+    /** @brief The width of the canvas in pixels */
+    inline int width(void) const noexcept
+    { return _columns * TILE_WIDTH; }
+
+    /** @brief The height of the canvas in pixels */
+    inline int height(void) const noexcept
+    { return _rows * TILE_HEIGHT; }
+
+    /**
+     * @brief Clear the bitmap
+     */
+    void clear(void) noexcept;
+
+    /**
+     * @brief Set or clear one pixel. Pixels outside the canvas are ignored.
+     *
+     * @param x The column, 0 is the left edge
+     * @param y The row, 0 is the top edge
+     * @param on True to set the pixel, false to clear it
+     */
+    void setPixel(int x, int y, bool on = true) noexcept;
+
+    /**
+     * @brief Read back a pixel from the bitmap
+     *
+     * @param x The column, 0 is the left edge
+     * @param y The row, 0 is the top edge
+     * @return true if the pixel is set
+     */
+    bool getPixel(int x, int y) const noexcept;
+
+    /**
+     * @brief Draw a line between two points, inclusive
+     *
+     * @param x0 The column of the first point
+     * @param y0 The row of the first point
+     * @param x1 The column of the second point
+     * @param y1 The row of the second point
+     * @param on True to set the pixels, false to clear them
+     */
+    void line(int x0, int y0, int x1, int y1, bool on = true) noexcept;
+
+    /**
+     * @brief Draw a line graph of values, one per pixel column starting at the left edge.
+     *
+     * The values are scaled so that min is at the bottom and max at the top of the canvas,
+     * and the points are joined with lines. The bitmap is *not* cleared first.
+     *
+     * @param values The values to plot
+     * @param count The number of values (at most width())
+     * @param min The value at the bottom edge
+     * @param max The value at the top edge
+     */
+    void plot(const int16_t values[], int count, int16_t min, int16_t max) noexcept;
+
+    /**
+     * @brief Scroll the bitmap left, clearing the columns on the right
+     *
+     * @param pixels The number of columns to scroll
+     */
+    void scrollLeft(int pixels = 1) noexcept;
+
+    /**
+     * @brief Add a point to a scrolling trend graph.
+     *
+     * The bitmap is scrolled left one column, and the new value is plotted in the rightmost
+     * column, joined to the previous point.
+     *
+     * @param value The value to plot
+     * @param min The value at the bottom edge
+     * @param max The value at the top edge
+     */
+    void push(int16_t value, int16_t min, int16_t max) noexcept;
+
+    /**
+     * @brief Send the changes to the display.
+     *
+     * Only the rows of the custom characters which changed since the last commit are sent.
+     * The first commit also places the tiles on the screen.
+     *
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display.
+     * @return (int) The number of custom character rows sent
+     */
+    int commit(bool Enable_Buffering = false) noexcept;
+
+    /**
+     * @brief Place the tiles on the screen again (for example after the screen was cleared)
+     * and send any changes.
+     *
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display.
+     */
+    inline void redraw(bool Enable_Buffering = false) noexcept
+    { _placed = false; commit(Enable_Buffering); }
+
+ private:
+
+    LCD_I2C &_lcd;
+    byte _line;
+    byte _position;
+    byte _columns;
+    byte _rows;
+    byte _firstGlyph;
+    bool _dirty = true;         // the bitmap changed since the last commit
+    bool _placed = false;       // the tiles are on the screen
+    int _lastY = -1;            // the last point pushed, -1 if none
+
+    // The bitmap, as custom characters. Tile t is at column t % _columns, row t / _columns
+    byte _bits[MAX_TILES][TILE_HEIGHT];
+
+    // Scale a value to a pixel row
+    int scale(int16_t value, int16_t min, int16_t max) const noexcept;
+};
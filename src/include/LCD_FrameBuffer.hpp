@@ -0,0 +1,201 @@
+/**
+ * @file LCD_FrameBuffer.hpp
+ * @author Keith Standiford
+ * @brief A screen image shared by both cores, protected by sequence locks
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022 Keith Standiford. All rights reserved.
+ * @remark Pi Pico only
+ *
+ */
+#pragma once
+
+#include <string.h>
+#include <atomic>
+#include <hardware/i2c.h>
+#include <hardware/sync.h>
+#include <LCD_I2C.hpp>
+
+/**
+ * @brief An image of the screen in RAM which code on either core (or in interrupt handlers)
+ * writes to, and a flusher sends to the display.
+ *
+ * Writers only touch RAM. Each line of the image has a sequence counter, which is odd while
+ * a writer is changing the line, and a bitmap of the cells changed since the last flush.
+ * Writers never wait for the I2C bus. They do take a hardware spin lock with each other for
+ * the few microseconds it takes to copy the characters in (the RP2040 has no atomic
+ * read-modify-write instructions), so a write is safe from an interrupt handler.
+ *
+ * The flusher (usually on one core, and often a repeating timer) takes a consistent snapshot
+ * of each changed line without any lock, retrying later if a writer was part way through,
+ * and sends only the changed cells which differ from what the display shows.
+ *
+ * The flusher can also limit the refresh rate. The display itself takes tens of milliseconds
+ * to show a change, so sending a value thousands of times a second only uses up the bus.
+ * With setFrameRate(), frame() can be called as often as you like, but sends the latest
+ * image at most once per frame, and no more than a set number of bytes per frame. Writes
+ * over cells whose last write has not been sent yet are counted by dropped().
+ *
+ * @note Only one flusher may run, and only the flusher may use the display.
+ */
+class LCD_FrameBuffer {
+ public:
+
+    using byte = uint8_t;
+
+    /**
+     * @brief Construct a blank screen image. Nothing is sent to the display.
+     *
+     * @param lcd The display to flush to
+     */
+    LCD_FrameBuffer(LCD_I2C &lcd) noexcept;
+
+    /**
+     * @brief Release the hardware spin lock
+     */
+    ~LCD_FrameBuffer();
+
+    /** @name Writer Functions
+     * 
+     * These can be called from either core or from interrupt handlers. They only change
+     * the image in RAM.
+     */
+    ///@{
+
+    /**
+     * @brief Write a string into the image. It is clipped at the end of the line.
+     *
+     * @param line The row (or line)
+     * @param position The position (or column)
+     * @param text The string to write
+     */
+    void write(byte line, byte position, const char text[]) noexcept;
+
+    /**
+     * @brief Write characters into the image. They are clipped at the end of the line.
+     *
+     * @param line The row (or line)
+     * @param position The position (or column)
+     * @param data The characters to write
+     * @param length The number of characters
+     */
+    void write(byte line, byte position, const byte data[], byte length) noexcept;
+
+    /**
+     * @brief Write one character into the image.
+     *
+     * @param line The row (or line)
+     * @param position The position (or column)
+     * @param c The character
+     */
+    void writeChar(byte line, byte position, byte c) noexcept;
+
+    /**
+     * @brief Fill part of a line of the image with one character.
+     *
+     * @param line The row (or line)
+     * @param position The position (or column) to start at
+     * @param c The character
+     * @param count The number of cells. It is clipped at the end of the line.
+     */
+    void fill(byte line, byte position, byte c, byte count) noexcept;
+
+    /**
+     * @brief Blank the whole image.
+     */
+    void clear(void) noexcept;
+    ///@}
+
+    /** @name Flusher Functions
+     */
+    ///@{
+
+    /**
+     * @brief Send the changed cells to the display.
+     *
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display.
+     * @return (int) The number of characters sent
+     */
+    int flush(bool Enable_Buffering = false) noexcept;
+
+    /**
+     * @brief Send the whole image at the next flush(), for example after the screen was cleared.
+     */
+    void redraw(void) noexcept;
+
+    /**
+     * @brief Limit the refresh rate used by frame().
+     *
+     * @param frames_per_second The most frames per second, typically 20 to 60 (0 for no limit)
+     * @param max_bytes_per_frame The most bytes to send in one frame (0 for no limit).
+     * Lines which do not fit are sent in the next frame. A line is always sent if it is 
+     * the first in its frame.
+     */
+    void setFrameRate(uint16_t frames_per_second, size_t max_bytes_per_frame = 0) noexcept;
+
+    /**
+     * @brief Send the changes if a new frame is due. Call as often as you like.
+     *
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display.
+     * @return (int) The number of characters sent
+     */
+    int frame(bool Enable_Buffering = false) noexcept;
+
+    /** @brief The number of lines caught part way through a write, and left for the next flush() */
+    inline uint32_t retries(void) const noexcept
+    { return _retries; }
+
+    /** @brief The number of frames sent by frame() */
+    inline uint32_t frames(void) const noexcept
+    { return _frames; }
+
+    /**
+     * @brief The number of writes which replaced an earlier write before it was sent: writes
+     * over cells changed since the last flush. Writes to other cells of the line are not counted.
+     */
+    inline uint32_t dropped(void) const noexcept
+    { return _dropped; }
+    ///@}
+
+ private:
+
+    static constexpr byte MAX_LINES = 4;
+    static constexpr byte MAX_WIDTH = 20;
+
+    struct Line {
+        std::atomic<uint32_t> seq {0};      // odd while a writer is changing the line
+        std::atomic<uint32_t> flushed {0};  // the seq last sent by the flusher
+        uint32_t dirty = 0;                 // cells changed since the flushed seq
+        byte text[MAX_WIDTH];
+    };
+
+    LCD_I2C &_lcd;
+    byte _rows;
+    byte _columns;
+    uint _spinLockNum;
+    spin_lock_t *_spinLock;
+    Line _lines[MAX_LINES];
+    volatile uint32_t _dropped = 0;         // written by the writers, under the spin lock
+
+    // Used only by the flusher
+    byte _shown[MAX_LINES][MAX_WIDTH];
+    bool _stale[MAX_LINES];                 // the display line does not match _shown
+    uint32_t _retries = 0;
+    uint32_t _frames = 0;
+    byte _nextRow = 0;                      // where the next flush starts
+    uint32_t _framePeriod = 0;              // in microseconds
+    uint32_t _nextFrame = 0;
+    size_t _frameBytes = SIZE_MAX;
+
+    // Send changed lines, starting at _nextRow, until about max_bytes have been used
+    int flush_lines(size_t max_bytes) noexcept;
+
+    // Start and finish a writer's change to a line
+    uint32_t begin_write(Line &line) noexcept;
+    void end_write(Line &line, uint32_t saved_irq) noexcept;
+};
@@ -8,9 +8,10 @@
  * @remark Based loosely on the Pico SDK example and the Arduino LiquidCrystal API
  *
  * These are the wrappers to allow the Fast LCD I2C driver (which is written in C++)
- * to be used from a C program. The interface is simplified, and the buffering commands are
- * not available since C does not allow optional arguments. None the less, this allows 
- * users who have not made the transition to C++ to still enjoy substantial speed improvements 
+ * to be used from a C program. The simple interface drives one display and sends every call
+ * immediately. The handle interface (lcdh_ functions) drives any number of displays kept in 
+ * caller provided storage, with no heap, and can buffer output like the C++ version. Either way,
+ * users who have not made the transition to C++ still enjoy substantial speed improvements 
  * over most other drivers.
  * 
  * Use of the C++ version is encouraged.
@@ -18,6 +19,8 @@
  **************************************************************************/
 #pragma once
 #include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
 #include <hardware/i2c.h>
 
 ///@cond    Do not document in DOXYGEN
@@ -32,9 +35,11 @@ extern "C" {
      * 
      * On the Pi Pico, if you prefer to work in C a reasonably complete 
      * subset of the program interface is available here with almost 
-     * all of the functionality of the C++ version. The advanced buffering commands 
-     * are *not* available. Even without them, substantial speed
-     * improvements are still achieved. (But C++ is still recommended.)
+     * all of the functionality of the C++ version. The simple lcd_ functions drive a
+     * single display and send every call as its own I2C transaction. The lcdh_ functions
+     * take a handle from lcd_create(), so several displays can be driven, and they
+     * take a `buffered` argument which works like Enable_Buffering in C++. 
+     * (But C++ is still recommended.)
      * @{
      */
 
@@ -55,7 +60,7 @@ extern "C" {
      * 
      * @note If called more than once, the existing LCD class object will be 
      * @note discarded (and destroyed), and a new one created and initialized with the given
-     * @note parameters. Use with care!
+     * @note parameters. Use with care! No heap is used; the display lives in static storage.
      * 
      * @warning The Pi Pico pins and the I2C bus are **not** initialized! (But see See LCD_I2C_Setup().)
      */
@@ -64,6 +69,159 @@ extern "C" {
     ///@}
 
 
+    /** @name Multiple displays without the heap
+     * Each display lives in an lcd_storage_t provided by the caller, usually a static 
+     * variable. lcd_create() builds the display in it and returns a handle for the lcdh_ 
+     * functions. Nothing is allocated.
+     * 
+     * The lcdh_ output functions take a `buffered` argument. If it is false, the output 
+     * is sent at once, just like the simple functions. If it is true, the output is only 
+     * added to the display's buffer, and lcd_show() sends all of it as one transaction.
+     * Batching a screen update this way is several times faster than sending each call.
+     */
+    ///@{
+
+///@cond
+#ifndef LCD_I2C_BUFFER_LENGTH
+#define LCD_I2C_BUFFER_LENGTH 128
+#endif
+#ifndef LCD_I2C_TEXT_CACHE_ENTRIES
+#define LCD_I2C_TEXT_CACHE_ENTRIES 0
+#endif
+#ifndef LCD_I2C_TEXT_CACHE_LENGTH
+#define LCD_I2C_TEXT_CACHE_LENGTH 20
+#endif
+///@endcond
+
+    /**
+     * @brief The size of an lcd_storage_t in bytes. 
+     * 
+     * It must hold an LCD_I2C object, which is checked when LCD_I2C-C.cpp is compiled.
+     * The default follows what the object holds: the output buffer (see LCD_I2C_BUFFER_LENGTH),
+     * the text cache (see LCD_I2C_TEXT_CACHE_ENTRIES), about 320 bytes of copies of the display's 
+     * memory and state, and room for pointers and any locking policy, with some to spare.
+     */
+#ifndef LCD_I2C_STORAGE_SIZE
+#define LCD_I2C_STORAGE_SIZE (LCD_I2C_BUFFER_LENGTH \
+        + LCD_I2C_TEXT_CACHE_ENTRIES * (5 * LCD_I2C_TEXT_CACHE_LENGTH + 12) + 320 + 24 * sizeof(void *))
+#endif
+
+    /**
+     * @brief Storage for one display. Treat it as opaque.
+     */
+    typedef struct lcd_storage {
+        union {
+            uint8_t bytes[LCD_I2C_STORAGE_SIZE];
+            long long align_ll;         // force the strictest alignment LCD_I2C needs
+            void *align_ptr;
+        } u;
+    } lcd_storage_t;
+
+    /**
+     * @brief A display created by lcd_create()
+     */
+    typedef struct lcd_display *lcd_handle_t;
+
+    /**
+     * @brief Create and initialize a display in caller provided storage.
+     * 
+     * @param storage Where the display lives. It must stay valid until lcd_destroy().
+     * @param address The I2C address
+     * @param columns The LCD's number of columns
+     * @param rows The LCD's number of rows (lines)
+     * @param I2C The I2C instance
+     * @return (lcd_handle_t) The handle for the lcdh_ functions
+     * 
+     * @warning The Pi Pico pins and the I2C bus are **not** initialized! (But see See LCD_I2C_Setup().)
+     */
+    lcd_handle_t lcd_create(lcd_storage_t *storage, byte address, byte columns, byte rows, i2c_inst_t *I2C) ;
+
+    /**
+     * @brief Send anything still buffered and destroy the display. The storage may then be reused.
+     * 
+     * @param h The display
+     */
+    void lcd_destroy(lcd_handle_t h) ;
+
+    /**
+     * @brief The handle of the display used by the simple lcd_ functions. 
+     * 
+     * It is created with the default parameters if lcd_init() has not been called.
+     * It is destroyed and replaced if lcd_init() is called again.
+     */
+    lcd_handle_t lcd_default(void) ;
+
+    /**
+     * @brief Send everything in the display's buffer as one I2C transaction.
+     * 
+     * @param h The display
+     * @return (int) The result of the I2C write
+     */
+    int lcd_show(lcd_handle_t h) ;
+
+    /**
+     * @brief The number of bytes waiting in the display's buffer
+     * 
+     * @param h The display
+     */
+    size_t lcd_backlog(lcd_handle_t h) ;
+
+    ///@}
+
+    /** @name Handle based output
+     * These are the same as the simple functions, for the display given by the handle.
+     * Where there is a `buffered` argument and it is true, the output is only added to 
+     * the display's buffer. See lcd_show(). The other functions send anything buffered 
+     * along with their own command, as in C++.
+     */
+    ///@{
+    /** @brief Output a character to the screen. */
+    void lcdh_writeChar(lcd_handle_t h, byte val, bool buffered) ;
+    /** @brief Output a string to the screen. */
+    void lcdh_writeString(lcd_handle_t h, const char str[], bool buffered) ;
+    /** @brief Write array of bytes */
+    void lcdh_writeBuffer(lcd_handle_t h, const uint8_t *buffer, size_t size, bool buffered) ;
+    /** @brief Move the input cursor to a location on the screen. */
+    void lcdh_setCursor(lcd_handle_t h, byte line, byte position, bool buffered) ;
+    /** @brief Clear the display. */
+    void lcdh_clear(lcd_handle_t h) ;
+    /** @brief "Home" the display. */
+    void lcdh_home(lcd_handle_t h) ;
+    /** @brief Turn on the display backlight */
+    void lcdh_backlight(lcd_handle_t h) ;
+    /** @brief Turn off the display backlight */
+    void lcdh_noBacklight(lcd_handle_t h) ;
+    /** @brief Turns the display on without modifying data on it. */
+    void lcdh_display(lcd_handle_t h) ;
+    /** @brief Turns the display off without modifying data on it. */
+    void lcdh_noDisplay(lcd_handle_t h) ;
+    /** @brief Display the underline cursor at the current cursor location. */
+    void lcdh_cursor(lcd_handle_t h) ;
+    /** @brief Hides the underline cursor at the current cursor location. */
+    void lcdh_noCursor(lcd_handle_t h) ;
+    /** @brief Display the blinking inverted cursor at the current cursor location */
+    void lcdh_blink(lcd_handle_t h) ;
+    /** @brief Disable the blinking inverted cursor at the current cursor location */
+    void lcdh_noBlink(lcd_handle_t h) ;
+    /** @brief Scrolls the display and cursor one position to the left. */
+    void lcdh_scrollDisplayLeft(lcd_handle_t h, bool buffered) ;
+    /** @brief Scrolls the display and cursor one position to the right. */
+    void lcdh_scrollDisplayRight(lcd_handle_t h, bool buffered) ;
+    /** @brief Turns on automatic scrolling of the display. */
+    void lcdh_autoscroll(lcd_handle_t h) ;
+    /** @brief Turns off automatic scrolling of the display. */
+    void lcdh_noAutoscroll(lcd_handle_t h) ;
+    /** @brief Sets the text direction to left to right. */
+    void lcdh_leftToRight(lcd_handle_t h) ;
+    /** @brief Sets the text direction to right to left. */
+    void lcdh_rightToLeft(lcd_handle_t h) ;
+    /** @brief Create a custom character. */
+    void lcdh_createChar(lcd_handle_t h, byte charnum, const byte char_map[]) ;
+    /** @brief Update a custom character, sending only the rows which changed. */
+    int lcdh_updateChar(lcd_handle_t h, byte charnum, const byte char_map[], bool buffered) ;
+    ///@}
+
+
     /** @name Writing to the screen on the Pi Pico in C
      * These are the simplist output routines for writing characters to the LCD screen. They
      * are in the spirit of the example in the Pi Pico SDK.  
@@ -261,6 +419,18 @@ extern "C" {
      */
     void lcd_createChar(byte charnum, const byte char_map[])  ;
 
+    /**
+     * @brief Update a custom character, sending only the rows which changed.
+     * 
+     * The new bitmap is compared with the one last loaded, and only the changed rows
+     * are sent. This is much faster than lcd_createChar() for animated characters.
+     *
+     * @param charnum The memory address (character code) 0-7
+     * @param char_map The byte array
+     * @return (int) The number of character rows sent to the display (0-8)
+     */
+    int lcd_updateChar(byte charnum, const byte char_map[])  ;
+
 /**\} */
 /**\} */
 
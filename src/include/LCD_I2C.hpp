@@ -23,8 +23,83 @@
 //  and some function alias'
 inline void sleep_ms(uint32_t time) {delay(time);}
 inline void sleep_us(uint64_t time) {delayMicroseconds(time);}
+inline uint32_t time_us_32(void) {return micros();}
 #else
 #include <stdint.h>
+#include <pico/time.h>
+#endif
+
+/*
+ * Locking policy, chosen at compile time by defining LCD_I2C_LOCKING (Pi Pico only).
+ *
+ *  LCD_I2C_LOCK_NONE      No locking. Use each display from one core only, and not from
+ *                         interrupt handlers. This is the default.
+ *  LCD_I2C_LOCK_SPINLOCK  A hardware spin lock per display. Safe from both cores and from
+ *                         interrupt handlers. Interrupts are disabled on the calling core
+ *                         while a call is in progress, so clear() and home() busy wait.
+ *  LCD_I2C_LOCK_MUTEX     A recursive mutex per display. Safe from both cores, but NOT from
+ *                         interrupt handlers. A core waiting for the display can still take interrupts.
+ */
+#define LCD_I2C_LOCK_NONE       0
+#define LCD_I2C_LOCK_SPINLOCK   1
+#define LCD_I2C_LOCK_MUTEX      2
+
+#ifndef LCD_I2C_LOCKING
+#define LCD_I2C_LOCKING LCD_I2C_LOCK_NONE
+#endif
+
+/*
+ * Output buffer options (Pi Pico only).
+ *
+ *  LCD_I2C_BUFFER_LENGTH  The size of the output buffer in bytes. The default is 128. 
+ *                         Rewriting a whole 20x4 screen takes about 420 bytes.
+ *  LCD_I2C_BUFFER_POOL    If 1, displays have no output buffer of their own. Each one borrows
+ *                         a buffer from a shared LCD_BufferPool while it has output waiting, and
+ *                         gives it back when the output has been sent. So the RAM used depends on
+ *                         how many displays are busy at once, not on how many there are.
+ */
+#ifndef LCD_I2C_BUFFER_LENGTH
+#define LCD_I2C_BUFFER_LENGTH 128
+#endif
+
+#ifndef LCD_I2C_BUFFER_POOL
+#define LCD_I2C_BUFFER_POOL 0
+#endif
+
+/*
+ * Text cache. writeString() keeps the bus bytes of recently written strings, so writing the
+ * same string again is a copy instead of encoding every character.
+ *
+ *  LCD_I2C_TEXT_CACHE_ENTRIES  The number of strings kept per display. The default is 0 (no cache).
+ *  LCD_I2C_TEXT_CACHE_LENGTH   The longest string kept. Longer strings are not cached. 
+ *                              The default is 20. Each entry takes about 5 bytes per character.
+ */
+#ifndef LCD_I2C_TEXT_CACHE_ENTRIES
+#define LCD_I2C_TEXT_CACHE_ENTRIES 0
+#endif
+
+#ifndef LCD_I2C_TEXT_CACHE_LENGTH
+#define LCD_I2C_TEXT_CACHE_LENGTH 20
+#endif
+
+#if LCD_I2C_BUFFER_POOL && defined(ARDUINO)
+#error "LCD_I2C_BUFFER_POOL is only available on the Pi Pico"
+#endif
+
+#if LCD_I2C_TEXT_CACHE_ENTRIES && __cplusplus < 201402L
+#error "LCD_I2C_TEXT_CACHE_ENTRIES needs C++14 or later"
+#endif
+
+#if LCD_I2C_LOCKING != LCD_I2C_LOCK_NONE
+#ifdef ARDUINO
+#error "LCD_I2C_LOCKING is only available on the Pi Pico"
+#elif LCD_I2C_LOCKING == LCD_I2C_LOCK_SPINLOCK
+#include <hardware/sync.h>
+#elif LCD_I2C_LOCKING == LCD_I2C_LOCK_MUTEX
+#include <pico/mutex.h>
+#else
+#error "Unknown LCD_I2C_LOCKING policy"
+#endif
 #endif
 
 //  For Arduino, we are part of the print class
@@ -39,6 +114,10 @@ inline void sleep_us(uint64_t time) {delayMicroseconds(time);}
  * \nosubgrouping
  * 
  */
+#if LCD_I2C_BUFFER_POOL
+class LCD_BufferPool;
+#endif
+
 #ifdef ARDUINO
 class LCD_I2C : public Print {
 #else
@@ -106,6 +185,9 @@ class LCD_I2C {
     static constexpr byte  MAX_LINES = 4;
     static constexpr byte  MAX_CHARS = 20;
 
+    static constexpr byte  MAX_CUSTOM_CHARS = 8;
+    static constexpr byte  CUSTOM_CHAR_ROWS = 8;
+
     byte  _Addr;
     byte _displayfunction;
     byte _displaycontrol;
@@ -117,6 +199,54 @@ class LCD_I2C {
     byte _last_mode;
 
     uint8_t row_address_offset[MAX_LINES] = {0x80, 0xC0, 0x80 + 20, 0xC0 + 20};
+
+    /*
+     * A copy of the custom character bitmaps last loaded into the display's
+     * CGRAM, so that updateChar() can send only the rows which changed.
+     * Bit n of _cgramValid is set once character n has been loaded.
+     */
+    byte _cgram[MAX_CUSTOM_CHARS][CUSTOM_CHAR_ROWS];
+    byte _cgramValid = 0;
+
+    /*
+     * Where the display's address counter points, followed from the commands and
+     * characters sent, so that writeUTF8() can come back after loading a glyph into CGRAM.
+     */
+    byte _address = 0;
+    bool _addressCGRAM = false;
+
+    /*
+     * A copy of the display RAM (two lines of 40), and how far the display is shifted
+     * left (0-39), kept as the commands and characters are buffered. With the 
+     * custom characters and the display modes, this is enough to put the screen back.
+     */
+    static constexpr uint8_t DDRAM_SIZE = 80;
+    byte _ddram[DDRAM_SIZE];
+    byte _shift = 0;
+
+    /*
+     * Connection state. After a failed write, output is dropped (the copy above is still kept),
+     * and the display is probed now and then until it answers, when recover() puts it back.
+     */
+    static constexpr uint32_t PROBE_INTERVAL_US = 100000;
+    bool _lost = false;
+    uint32_t _lostAt = 0;
+    uint32_t _probeAt = 0;
+    uint32_t _recoveries = 0;
+    uint32_t _recoveryUs = 0;
+    uint32_t _outageUs = 0;
+
+    /*
+     * UTF-8 text. The character ROM in the display, and the custom characters which 
+     * writeUTF8() may use for characters the ROM lacks: which character each one holds
+     * (0 if none), and the writeUTF8() call which last used it.
+     */
+    byte _rom = 0;
+    byte _glyphFirst = 0;
+    byte _glyphCount = 0;
+    uint16_t _glyphChar[MAX_CUSTOM_CHARS] = {};
+    uint16_t _glyphUsed[MAX_CUSTOM_CHARS] = {};
+    uint16_t _utf8Calls = 0;
     
     /*
      * For Arduino, the I2C interface (Wire) has an internal buffer
@@ -146,10 +276,26 @@ class LCD_I2C {
             #endif
         #endif
     #else
-    static constexpr size_t  BUFFER_LENGTH = 128;
+    static constexpr size_t  BUFFER_LENGTH = LCD_I2C_BUFFER_LENGTH;
     #endif
 
+    #if LCD_I2C_BUFFER_POOL
+    /*
+     * Until a buffer is borrowed from the pool (or if none is free), a spare
+     * just big enough for one command is used, and each command is sent at once.
+     */
+    static constexpr size_t SPARE_LENGTH = 5;
+    byte _spare[SPARE_LENGTH];
+    byte *_buffer = _spare;
+    size_t _capacity = SPARE_LENGTH;
+    static LCD_BufferPool *_pool;
+
+    void borrow_buffer(void)  noexcept;
+    void return_buffer(void)  noexcept;
+    #else
     byte _buffer[BUFFER_LENGTH];
+    static constexpr size_t _capacity = BUFFER_LENGTH;
+    #endif
 
 
     /*
@@ -158,6 +304,59 @@ class LCD_I2C {
      */
     size_t _bufferIn = 0;  
 
+    /*
+     * The next byte to transmit, when the buffer is being sent a piece at a time by showSome().
+     */
+    size_t _bufferOut = 0;
+
+    /*
+     * Cooperative mode. Nothing is sent except by poll() (or when the buffer
+     * must make room). Slow commands (clear and home) in the buffer are remembered
+     * in _holdAt, and once one has been sent, nothing more is sent until _holdUntil.
+     */
+    bool _cooperative = false;
+    static constexpr byte MAX_HOLDS = 4;
+    size_t _holdAt[MAX_HOLDS];
+    byte _holds = 0;
+    bool _holding = false;
+    uint32_t _holdUntil = 0;
+    uint32_t _usPerByte16 = 90 * 16;    // bus time per byte in 1/16 us, starting at 100 kHz
+
+    /*
+     * The number of public calls in progress (counted by Guard), so that the
+     * auto flush alarm never sends while the buffer is being changed.
+     */
+    volatile byte _calls = 0;
+
+    /*
+     * The text cache, indexed by a hash of the string, two entries to a string. The text is
+     * kept too, so a hit is certain. The bus bytes have the backlight bit set, as from encodeByte().
+     */
+    #if LCD_I2C_TEXT_CACHE_ENTRIES
+    struct TextCacheEntry {
+        uint32_t hash;
+        byte length;                                        // 0 if unused
+        bool recent;                                        // used more recently than its pair
+        char text[LCD_I2C_TEXT_CACHE_LENGTH];
+        byte wire[4 * LCD_I2C_TEXT_CACHE_LENGTH];
+    };
+    TextCacheEntry _textCache[LCD_I2C_TEXT_CACHE_ENTRIES] {};
+    uint32_t _cacheHits = 0;
+    uint32_t _cacheMisses = 0;
+    #endif
+
+    /*
+     * Auto flush (write-behind). The alarm is armed by the first buffered byte,
+     * and flushes once nothing has been written for _autoFlushUs.
+     */
+    #ifndef ARDUINO
+    static constexpr uint32_t AUTO_FLUSH_RETRY_US = 100;
+    uint32_t _autoFlushUs = 0;
+    size_t _autoFlushFill = 0;
+    uint32_t _lastWrite = 0;
+    volatile alarm_id_t _alarm = 0;
+    #endif
+
     /*
      * The Pico system needs to know which I2C hardware to use, so we need
      * to save it! Note that on Arduino systems with more than one I2C bus,
@@ -167,6 +366,22 @@ class LCD_I2C {
     i2c_inst *I2C_instance {nullptr};
     #endif
 
+    /*
+     * The lock for the locking policy. The spin lock is made recursive by
+     * remembering which core holds it. (Interrupts are off while it is held,
+     * so nothing else on that core can be inside.)
+     */
+    #if LCD_I2C_LOCKING == LCD_I2C_LOCK_SPINLOCK
+    static constexpr uint NO_OWNER = ~0u;
+    uint _spinLockNum;
+    spin_lock_t *_spinLock;
+    volatile uint _lockOwner = NO_OWNER;
+    uint _lockDepth = 0;
+    uint32_t _savedIrq = 0;
+    #elif LCD_I2C_LOCKING == LCD_I2C_LOCK_MUTEX
+    recursive_mutex_t _mutex;
+    #endif
+
     /**
      * Output a byte to the interface chip.
      *
@@ -188,6 +403,93 @@ class LCD_I2C {
      */
     void send_byte(byte val, int mode, bool Enable_Buffering = false)  noexcept;
 
+    /*
+     * Follow the address counter for a command or character sent, or for encoded bytes.
+     */
+    void track(byte val, int mode)  noexcept;
+    void track_encoded(const byte wire[], size_t length)  noexcept;
+
+    /*
+     * Blank the characters of one display RAM line from index first in the copy of it, for
+     * count characters, bridging single blanks. Adds the bytes it takes to bytes, and only
+     * sends them if send is true. Returns the number of characters.
+     */
+    int blank_cells(byte first, byte count, bool send, size_t &bytes)  noexcept;
+
+    /*
+     * Write one byte to the expander to see if the display answers, and handle a failed write.
+     */
+    bool probe(void)  noexcept;
+    void lost_connection(void)  noexcept;
+
+    /*
+     * Initialize the display again and replay the display RAM, custom characters and modes.
+     */
+    void recover(void)  noexcept;
+
+    /*
+     * The character code to send for a Unicode character, loading a glyph if need be.
+     */
+    byte utf8_code(uint32_t unicode)  noexcept;
+
+    /*
+     * Finish a character or command added to the buffer: show it, or start the auto flush.
+     */
+    void end_write(bool Enable_Buffering)  noexcept;
+
+    /*
+     * Copy encoded bytes into the buffer, fixing the backlight bit.
+     */
+    void copy_encoded(const byte wire[], size_t length)  noexcept;
+
+    /*
+     * Put the mode byte for characters in the buffer, if the last byte sent was a command.
+     */
+    void character_mode(void)  noexcept;
+
+    #if LCD_I2C_TEXT_CACHE_ENTRIES
+    /*
+     * Write a string through the text cache. Returns false, having written nothing,
+     * if the string is too long to cache.
+     */
+    bool write_cached(const char s[])  noexcept;
+    #endif
+
+    /**
+     * Send the rows of consecutive custom characters which differ from the copy of CGRAM.
+     * The display is left addressing CGRAM. Returns the number of rows sent.
+     */
+    int send_char_rows(byte first, byte count, const byte *char_maps)  noexcept;
+
+    /*
+     * Buffer a clear or home command. Returns the time it takes.
+     */
+    uint32_t start_slow_command(byte command)  noexcept;
+
+    /*
+     * Helpers for cooperative mode. safe_length() is the longest part of the backlog, up 
+     * to max_bytes, which ends between characters or commands and before any slow command
+     * waiting in the buffer. 
+     */
+    bool holding(void)  noexcept;
+    void wait_hold(void)  noexcept;
+    int drain_some(void)  noexcept;
+    size_t safe_length(size_t max_bytes) const  noexcept;
+    void make_room(size_t count)  noexcept;
+
+    /*
+     * Take the lock if it is free (or busy only briefly). For the auto flush alarm.
+     */
+    bool try_lock(void)  noexcept;
+
+    #ifndef ARDUINO
+    /*
+     * The auto flush alarm callback, and the work it does.
+     */
+    static int64_t auto_flush_alarm(alarm_id_t id, void *lcd)  noexcept;
+    int64_t auto_flush(void)  noexcept;
+    #endif
+
     /**
      * Helper function to put the display in a known state.
      *
@@ -210,6 +512,36 @@ class LCD_I2C {
      */
     static constexpr uint8_t CUSTOM_SYMBOL_SIZE = 8;
 
+    /**
+     * @brief The number of custom characters the display holds, numbered from 0
+     * 
+     */
+    static constexpr uint8_t CUSTOM_CHARS = MAX_CUSTOM_CHARS;
+
+    /**
+     * @brief The number of characters in a line of display RAM (on one and two line displays)
+     * 
+     */
+    static constexpr uint8_t DDRAM_LINE_LENGTH = 40;
+
+    /**
+     * @brief The time the display needs to carry out clear() or home(), in microseconds
+     * 
+     */
+    static constexpr uint32_t CLEAR_TIME_US = 2000;
+
+    /**
+     * @brief The number of steps in initStep()
+     * 
+     */
+    static constexpr uint8_t INIT_STEPS = 5;
+
+    /**
+     * @brief The size of the output buffer (see LCD_I2C_BUFFER_LENGTH)
+     * 
+     */
+    static constexpr size_t OUTPUT_BUFFER_LENGTH = BUFFER_LENGTH;
+
     /** @brief needed for Arduino Constructor */
     static constexpr byte  LCD_5x10DOTS = 0x04; 
     /** @brief needed for Arduino Constructor */
@@ -287,6 +619,8 @@ class LCD_I2C {
      * @param columns The LCD's number of columns
      * @param rows The LCD's number of rows (lines)
      * @param I2C The I2C instance
+     * @param Initialize If true or missing, the display is initialized, which takes about 60 ms. 
+     * If false, nothing is sent, and the display must be initialized with initStep().
      * @note The Pi Pico pins and the I2C bus are **not** initialized! (See LCD_I2C_Setup())
      * 
      * The Pico constructor initializes the object using the
@@ -305,7 +639,13 @@ class LCD_I2C {
      * The bus speed is set during the I2C bus initialization.
      * 
      */
-    LCD_I2C(byte address, byte columns, byte rows, i2c_inst *I2C = PICO_DEFAULT_I2C_INSTANCE) noexcept;
+    LCD_I2C(byte address, byte columns, byte rows, i2c_inst *I2C = PICO_DEFAULT_I2C_INSTANCE,
+            bool Initialize = true) noexcept;
+
+    /**
+     * @brief Cancels the auto flush alarm, and releases the display's hardware spin lock if there is one
+     */
+    ~LCD_I2C();
     ///@}
 
     #endif
@@ -415,6 +755,254 @@ class LCD_I2C {
     } ;
     ///@}
 
+    /** @name Pre-encoded text
+     * Fixed labels can be encoded into the bytes sent over the bus when the program is 
+     * compiled. Declare them `static constexpr` and they live in flash:
+     * 
+     *      static constexpr auto TEMP = LCD_I2C::encode("Temp:");
+     *      lcd.setCursor(0, 0, true);
+     *      lcd.writeEncoded(TEMP);
+     * 
+     * writeEncoded() copies the bytes straight into the output buffer, so there is no 
+     * work per character at run time. The result on the display is the same as writeString().
+     * (Needs C++14 or later.)
+     */
+    ///@{
+
+    /**
+     * @brief Text encoded as bytes for the bus, 4 per character. See encode().
+     * 
+     * @tparam N The number of characters
+     */
+    template <size_t N>
+    struct Encoded {
+        static constexpr size_t LENGTH = 4 * N;     ///< The number of bytes
+        byte wire[N ? LENGTH : 1];                  ///< The bytes, with the backlight bit set
+    };
+
+    #if __cplusplus >= 201402L
+    /**
+     * @brief Encode a string literal when the program is compiled
+     * 
+     * @param text The string literal
+     * @return (Encoded<N-1>) The bytes to send for the characters of text
+     */
+    template <size_t N>
+    static constexpr Encoded<N - 1> encode(const char (&text)[N]) noexcept
+    {
+        Encoded<N - 1> result {};
+        for(size_t i = 0; i + 1 < N; i++)
+            encodeByte((byte)text[i], false, &result.wire[4 * i]);
+        return result;
+    }
+
+    /**
+     * @brief Encode one character or command as the 4 bytes sent for it, with the backlight bit set
+     * 
+     * @param val The character or command
+     * @param command True for a command, false for a character
+     * @param wire Where to put the 4 bytes
+     */
+    static constexpr void encodeByte(byte val, bool command, byte wire[]) noexcept
+    {
+        byte mode = (command ? LCD_COMMAND : LCD_CHARACTER) | LCD_BACKLIGHT;
+        byte high = (val & 0xF0u) | mode;
+        byte low = ((val & 0xFu) << 4) | mode;
+        wire[0] = high | ENABLE;
+        wire[1] = high;
+        wire[2] = low | ENABLE;
+        wire[3] = low;
+    }
+    #endif
+
+    /**
+     * @brief The byte which must be sent before switching between commands and characters
+     * 
+     * @param command True before commands, false before characters
+     */
+    static constexpr byte encodeMode(bool command) noexcept
+    { return (command ? LCD_COMMAND : LCD_CHARACTER) | LCD_BACKLIGHT; }
+
+    /**
+     * @brief The command which moves the cursor to a location, as sent by setAddress()
+     * 
+     * @param line The row (or line) on the display
+     * @param position The position on the row (or column) on the display
+     */
+    static constexpr byte addressCommand(byte line, byte position) noexcept
+    { return LCD_SETDDRAMADDR + (line & 1 ? 0x40 : 0) + (line & 2 ? 20 : 0) + position; }
+
+    /**
+     * @brief Write text made by encode() at the cursor
+     * 
+     * @param text The encoded text
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display.
+     */
+    template <size_t N>
+    inline void writeEncoded(const Encoded<N> &text, bool Enable_Buffering = false) noexcept
+    { writeEncoded(text.wire, Encoded<N>::LENGTH, Enable_Buffering); }
+
+    /**
+     * @brief Write characters already encoded as bytes for the bus
+     * 
+     * @param wire The bytes, 4 per character, as made by encode()
+     * @param length The number of bytes. Only whole characters are sent.
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display.
+     */
+    void writeEncoded(const byte wire[], size_t length, bool Enable_Buffering = false) noexcept;
+
+    /**
+     * @brief Send commands and characters already encoded as bytes for the bus
+     * 
+     * This is for streams built with encodeMode(), encodeByte() and addressCommand(), such as
+     * an LCD_Screen. The stream must start with a mode byte and end with a character.
+     * 
+     * @param wire The bytes, with the backlight bit set
+     * @param length The number of bytes
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display.
+     */
+    void sendEncoded(const byte wire[], size_t length, bool Enable_Buffering = false) noexcept;
+
+    /**
+     * @brief The number of strings writeString() keeps encoded (see LCD_I2C_TEXT_CACHE_ENTRIES)
+     */
+    static constexpr size_t TEXT_CACHE_ENTRIES = LCD_I2C_TEXT_CACHE_ENTRIES;
+
+    #if LCD_I2C_TEXT_CACHE_ENTRIES
+    /**
+     * @brief The number of writeString() calls which found their string in the text cache
+     */
+    inline uint32_t cacheHits(void) const noexcept
+    { return _cacheHits; }
+
+    /**
+     * @brief The number of writeString() calls which had to encode their string
+     * 
+     * Strings too long for the cache are not counted.
+     */
+    inline uint32_t cacheMisses(void) const noexcept
+    { return _cacheMisses; }
+
+    /**
+     * @brief The RAM used by the text cache, in bytes
+     */
+    static constexpr size_t cacheBytes(void) noexcept
+    { return sizeof(_textCache); }
+
+    /**
+     * @brief Empty the text cache and reset its counts
+     */
+    void clearCache(void) noexcept;
+    #endif
+    ///@}
+
+    /** @name Connection and recovery
+     * The driver keeps a copy of everything on the screen: the display RAM, the custom characters,
+     * the display shift and modes, and the cursor. If a write to the display fails (it was unplugged,
+     * or lost power), output is dropped but the copy is still kept up to date. When the display
+     * answers again, it is initialized and the copy is replayed in as few transactions as the
+     * buffer allows, so the screen comes back as it should be without the program redrawing it.
+     * 
+     * While the display is missing, show() looks for it every 100 ms. Auto flush never does,
+     * since it runs in an interrupt. In cooperative mode, nothing happens until
+     * checkConnection() is called, since recovery takes about 60 ms.
+     */
+    ///@{
+
+    /**
+     * @brief Look for the display now, and recover it if it has come back
+     * 
+     * A display which was thought connected is checked as well, so this can be called
+     * now and then to notice a missing display before anything is written.
+     * 
+     * @return (bool) True if the display answered
+     */
+    bool checkConnection(void) noexcept;
+
+    /**
+     * @brief False from a failed write until the display has been recovered
+     */
+    inline bool connected(void) const noexcept
+    { return !_lost; }
+
+    /**
+     * @brief The number of times the display has been recovered
+     */
+    inline uint32_t recoveries(void) const noexcept
+    { return _recoveries; }
+
+    /**
+     * @brief The time in microseconds the last recovery took, from finding the display to the
+     * screen being restored. Most of it is the display's own power up and initialization time.
+     */
+    inline uint32_t recoveryTime(void) const noexcept
+    { return _recoveryUs; }
+
+    /**
+     * @brief The time in microseconds from the first failed write to finding the display again,
+     * for the last recovery
+     */
+    inline uint32_t outageTime(void) const noexcept
+    { return _outageUs; }
+    ///@}
+
+    /** @name UTF-8 text
+     * writeUTF8() translates UTF-8 text, such as string literals in most source files, into the
+     * codes of the display's character ROM. Displays come with one of two ROMs, so tell it 
+     * which with setCharacterROM(). Characters the ROM lacks are drawn with custom characters, 
+     * if some are set aside with setGlyphSlots(), and shown as '?' otherwise.
+     * 
+     * ROM A00 (Japanese, the most common) has ASCII except \\ and ~, the half width katakana,
+     * and a few Greek and European characters, such as ° µ Ω ä ö ü ß and the arrows → ←.
+     * ROM A02 (European) has ASCII and the Latin-1 characters (U+00A0 to U+00FF) at their own codes.
+     * Codes below 0x20 are passed through, so the custom characters can still be written.
+     */
+    ///@{
+
+    /** @brief The character ROMs of the HD44780 */
+    enum CharacterROM : byte {
+        ROM_A00,        ///< Japanese, the usual one
+        ROM_A02         ///< European
+    };
+
+    /**
+     * @brief Tell writeUTF8() which character ROM the display has
+     * 
+     * @param rom ROM_A00 or ROM_A02
+     */
+    inline void setCharacterROM(CharacterROM rom) noexcept
+    { _rom = rom; }
+
+    /**
+     * @brief Set aside custom characters for writeUTF8() to draw characters the ROM lacks
+     * 
+     * Glyphs are loaded as they are needed. When more are needed than there are slots,
+     * the one used least recently is replaced, which also changes it wherever it is still shown.
+     * A single call never replaces a glyph it has used. By default no slots are set aside.
+     * 
+     * @param first The first custom character (0-7) to use
+     * @param count The number of custom characters to use, 0 for none
+     */
+    void setGlyphSlots(byte first, byte count) noexcept;
+
+    /**
+     * @brief Output a UTF-8 string to the screen
+     * 
+     * @param str The string
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display.
+     * @return (size_t) The number of characters (screen cells) written
+     */
+    size_t writeUTF8(const char str[], bool Enable_Buffering = false) noexcept;
+    ///@}
+
     /** @name Simple display control
      *      
      */
@@ -470,15 +1058,106 @@ class LCD_I2C {
     ///@cond
     #endif    
 
+    /**
+     * @brief Move the input cursor to a display RAM location, beyond the edge of the screen if desired.
+     * 
+     * This works like setCursor(), but the parameters are in the *same* order on Arduino and
+     * Pi Pico, which makes it the natural choice for code shared between both. The position is 
+     * also not limited to the width of the screen. On one and two line displays, the display
+     * RAM holds 40 characters per line, and the characters beyond the edge of the screen can
+     * be written here and brought into view with scrollDisplayLeft(). (On four line displays,
+     * lines 0 and 2 share one display RAM line, as do lines 1 and 3.)
+     * 
+     * @param line Specifies the row (or line) on the display
+     * @param position Specifies the position in the display RAM line (0-39)
+     * @param Enable_Buffering If true, the command is simply added to the output buffer.
+     * If false or missing, the command is added to the output buffer and the buffer
+     * is immediately written to the display. 
+     */
+    void setAddress(byte line, byte position, bool Enable_Buffering = false) noexcept;
+
+    /**
+     * @brief Write characters, sending only those which differ from what is already shown.
+     * 
+     * The characters in data are compared with the characters in shown, which is the 
+     * caller's record of what the display holds at the same locations. Only the runs of changed
+     * characters are sent, each preceded by setAddress(). Runs separated by a single unchanged
+     * character are merged, since resending one character costs less than a new address command.
+     * shown is updated to match data.
+     * 
+     * @param line Specifies the row (or line) on the display
+     * @param position Specifies the position of the first character in the display RAM line
+     * @param data The characters to display
+     * @param shown The characters currently displayed. Updated on return.
+     * @param length The number of characters
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display. 
+     * @return (int) The number of characters sent
+     */
+    int writeChanges(byte line, byte position, const byte data[], byte shown[], byte length, 
+            bool Enable_Buffering = false) noexcept;
+
+    /**
+     * @brief The number of columns (characters per line) on the display
+     */
+    inline byte columns(void) const noexcept
+    { return _cols; }
+
+    /**
+     * @brief The number of rows (lines) on the display
+     */
+    inline byte rows(void) const noexcept
+    { return _rows; }
+
     /**
      * @brief Clear the display.
      *
      * All data on the display is erased and the cursor returns to the top left (0,0) location.
-     * This command causes the buffer to be output to the display before execution. It also 
-     * takes a long time. 
+     * This command causes the buffer to be output to the display before execution.
+     * 
+     * The display's own clear command takes 2 ms. When only a few characters are showing, it is
+     * quicker to write spaces over them, which is done instead if the bus time is less.
+     * The bus time comes from measuring each transaction sent, starting from 100 kHz.
+     * Either way the display ends up the same. Like the display's clear command, it leaves
+     * the display writing left to right, as leftToRight() does.
      */
     void clear(void) noexcept;
 
+    /**
+     * @brief Blank one line, sending only the characters which are not blank already
+     * 
+     * On one and two line displays, the whole display RAM line is blanked, including the part
+     * which is off the screen unless the display is shifted. The cursor is left where it was.
+     * 
+     * @param line Specifies the row (or line) on the display
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display. 
+     * @return (int) The number of characters sent
+     */
+    inline int clearLine(byte line, bool Enable_Buffering = false) noexcept
+    { return clearRegion(line, 0, _rows > 2 ? _cols : DDRAM_LINE_LENGTH, 1, Enable_Buffering); }
+
+    /**
+     * @brief Blank a rectangle of the display RAM, sending only the characters which are not blank already
+     * 
+     * Like writeChanges(), runs separated by a single blank are sent as one. The cursor is left where
+     * it was. The blanks are written left to right, even when the display is set to right to left
+     * or autoscroll.
+     * 
+     * @param line Specifies the row (or line) of the top left character
+     * @param position Specifies the position of the top left character in the display RAM line
+     * @param width The width in characters
+     * @param height The height in rows (lines)
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display. 
+     * @return (int) The number of characters sent
+     */
+    int clearRegion(byte line, byte position, byte width, byte height,
+            bool Enable_Buffering = false) noexcept;
+
     /**
      * @brief "Home" the display. 
      * 
@@ -605,18 +1284,21 @@ class LCD_I2C {
      * @brief Scrolls the display and cursor one position to the left.
      * home() will restore it to its original position
      *
-     * This command is never buffered and causes the buffer to be flushed
-     * before execution.
+     * @param Enable_Buffering If true, the command is simply added to the output buffer.
+     * If false or missing, the command is added to the output buffer and the buffer
+     * is immediately written to the display. 
      */
-    void scrollDisplayLeft(void) noexcept;
+    void scrollDisplayLeft(bool Enable_Buffering = false) noexcept;
 
     /**
      * @brief Scrolls the display and cursor one position to the right.
      * home() will restore it to its original position
      *
-     * This command causes the buffer to be output to the display before execution. 
+     * @param Enable_Buffering If true, the command is simply added to the output buffer.
+     * If false or missing, the command is added to the output buffer and the buffer
+     * is immediately written to the display. 
      */
-    void scrollDisplayRight(void) noexcept;
+    void scrollDisplayRight(bool Enable_Buffering = false) noexcept;
 
     /**
      * @brief Turns on automatic scrolling of the display.
@@ -689,6 +1371,48 @@ class LCD_I2C {
     {	// alias for createChar()
         createChar(char_num, rows);
     };
+
+    /**
+     * @brief Update a custom character, sending only the rows which changed.
+     * 
+     * The new bitmap is compared with the one last loaded by createChar() or updateChar(),
+     * and only the changed rows are sent. The CGRAM address is set to the first changed row
+     * and each contiguous run of changed rows is sent in one sequence. (Runs separated by a 
+     * single unchanged row are merged, since resending one row is no more expensive than 
+     * setting a new address.) This makes animating a custom character (spinners, level meters,
+     * blinking icons) several times cheaper than calling createChar() for every frame.
+     * 
+     * If the character has never been loaded, all 8 rows are sent. If nothing changed,
+     * nothing at all is sent. Otherwise, as with createChar(), the cursor is left at 0,0.
+     * 
+     * @param charnum The memory address (character code) 0-7
+     * @param char_map The byte array
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display.
+     * @return (int) The number of character rows sent to the display (0-8)
+     */
+    int updateChar(byte charnum, const byte char_map[], bool Enable_Buffering = false)  noexcept;
+
+    /**
+     * @brief Update several consecutive custom characters, sending only the rows which changed.
+     * 
+     * This works like updateChar(), but the characters are compared as one continuous block of
+     * rows, just as they are stored in the display. A run of changed rows can continue from the 
+     * bottom of one character into the top of the next, and the data RAM address is only 
+     * restored once at the end. This is the most efficient way to update a group of custom 
+     * characters used as tiles of a larger picture.
+     * 
+     * @param first The memory address (character code) of the first character, 0-7
+     * @param count The number of characters to update
+     * @param char_maps The byte arrays for the characters
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display.
+     * @return (int) The number of character rows sent to the display
+     */
+    int updateChars(byte first, byte count, const byte char_maps[][CUSTOM_CHAR_ROWS], 
+            bool Enable_Buffering = false)  noexcept;
     ///@}
 
     /**
@@ -712,6 +1436,174 @@ class LCD_I2C {
      */
     int show(void) noexcept;
     ///@}
+
+    /**
+     * @name Sharing a Display between Cores
+     * 
+     * Every call takes the display's lock (see LCD_I2C_LOCKING), so calls from different cores
+     * can not mix their bytes. To keep a *sequence* of calls together, such as setCursor() followed by
+     * writeString(), hold the lock for the whole sequence with lock() and unlock(), or with a Guard.
+     * With no locking policy (the default), these do nothing.
+     */
+    ///@{
+
+    /**
+     * @brief Take the display's lock. It may be taken again by the same core.
+     * Each lock() must be matched by an unlock().
+     */
+    #if LCD_I2C_LOCKING == LCD_I2C_LOCK_NONE
+    inline void lock(void) noexcept {}
+    #else
+    void lock(void) noexcept;
+    #endif
+
+    /**
+     * @brief Release the display's lock.
+     */
+    #if LCD_I2C_LOCKING == LCD_I2C_LOCK_NONE
+    inline void unlock(void) noexcept {}
+    #else
+    void unlock(void) noexcept;
+    #endif
+
+    /**
+     * @brief Holds a display's lock for as long as it exists.
+     * 
+     * `LCD_I2C::Guard guard(lcd);` keeps the calls that follow in the same scope together.
+     */
+    class Guard {
+     public:
+        /** @brief Take the lock of a display */
+        explicit Guard(LCD_I2C &lcd) noexcept : _lcd(lcd) { _lcd.lock(); _lcd._calls = _lcd._calls + 1; }
+        /** @brief Release the lock */
+        ~Guard() { _lcd._calls = _lcd._calls - 1; _lcd.unlock(); }
+        Guard(const Guard &) = delete;
+        Guard &operator=(const Guard &) = delete;
+     private:
+        LCD_I2C &_lcd;
+    };
+    ///@}
+
+    /**
+     * @name Control without Waiting
+     * 
+     * These do the same work as show(), clear(), home() and the display initialization,
+     * but never sleep. Instead they return the time the caller must let pass before the
+     * display can be used again, so a scheduler can run other work meanwhile.
+     * (See LCD_Async.hpp for C++20 coroutine versions.)
+     */
+    ///@{
+
+    /**
+     * @brief Transmit up to max_bytes of the buffer.
+     * 
+     * The buffer can be sent in pieces, with other work in between. More data may be added to 
+     * the buffer meanwhile. A piece always ends between whole characters or commands, so at 
+     * least 5 bytes are needed to make progress.
+     * 
+     * @param max_bytes The most bytes to transmit
+     * @return (int)  The number of bytes transmitted
+     */
+    int showSome(size_t max_bytes) noexcept;
+
+    /**
+     * @brief The number of bytes waiting in the buffer to be transmitted
+     */
+    inline size_t backlog(void) const noexcept
+    { return _bufferIn - _bufferOut; }
+
+    /**
+     * @brief Send the clear command (and anything in the buffer) without waiting for it to finish.
+     * 
+     * @return (uint32_t) The time in microseconds before the display can be used again
+     */
+    uint32_t startClear(void) noexcept;
+
+    /**
+     * @brief Send the home command (and anything in the buffer) without waiting for it to finish.
+     * 
+     * @return (uint32_t) The time in microseconds before the display can be used again
+     */
+    uint32_t startHome(void) noexcept;
+
+    /**
+     * @brief Carry out one step of initializing the display.
+     * 
+     * Call with step 0 to INIT_STEPS-1 in order, letting the returned time pass after each one.
+     * (This is what the constructor does, unless told not to.)
+     * 
+     * @param step The step, 0 to INIT_STEPS-1
+     * @return (uint32_t) The time in microseconds before the next step
+     */
+    uint32_t initStep(byte step) noexcept;
+
+    /**
+     * @brief Turn cooperative mode on or off.
+     * 
+     * In cooperative mode, calls only add to the buffer, and nothing is sent until poll()
+     * is called. (show() does nothing, and clear() and home() do not wait.) This suits a main loop
+     * with a fixed time budget for each pass. Slow commands are handled by poll(), which
+     * sends nothing more until they have finished.
+     * 
+     * If the buffer fills up, only the few bytes needed to make room are sent at once.
+     * Turning cooperative mode off sends nothing; the next show() sends the backlog.
+     * 
+     * @param on True for cooperative mode
+     */
+    void setCooperative(bool on) noexcept;
+
+    /**
+     * @brief True in cooperative mode
+     */
+    inline bool cooperative(void) const noexcept
+    { return _cooperative; }
+
+    /**
+     * @brief Send part of the backlog, limited by bytes and by time.
+     * 
+     * Only whole characters and commands are sent. The time limit uses a running measurement
+     * of the bus speed, so the first calls may be slightly off.
+     * 
+     * @param max_bytes The most bytes to transmit
+     * @param max_us The longest time to spend, in microseconds, or 0 for no limit
+     * @return (int)  The number of bytes transmitted. Use backlog() to see what remains.
+     */
+    int poll(size_t max_bytes = BUFFER_LENGTH, uint32_t max_us = 0) noexcept;
+
+    #ifndef ARDUINO
+    /**
+     * @brief Flush buffered data automatically (write-behind). Pi Pico only.
+     * 
+     * With auto flush on, buffered output no longer waits for show(). The first buffered byte
+     * arms a hardware alarm, and the buffer is sent once nothing more has been written for
+     * idle_us. The buffer is also sent at once when it holds fill_level bytes. So calls can
+     * use Enable_Buffering = true for the speed of batching, without ever leaving stale text on
+     * the screen.
+     * 
+     * @note The flush runs in the alarm interrupt, and takes about 90 us per byte at 100 kHz.
+     * If the alarm fires during a call to the display, it tries again shortly after.
+     * It never waits or sleeps: it does not look for a missing display, which is left to the
+     * next show() or checkConnection(), and it waits out a slow command by trying again later.
+     * @note Auto flush does nothing in cooperative mode.
+     * 
+     * @param idle_us The idle time before flushing in microseconds, or 0 to turn auto flush off
+     * @param fill_level Flush as soon as this many bytes are waiting (0 for only when full)
+     */
+    void setAutoFlush(uint32_t idle_us, size_t fill_level = 0) noexcept;
+    #endif
+
+    #if LCD_I2C_BUFFER_POOL
+    /**
+     * @brief Set the pool which all displays borrow their output buffers from.
+     * 
+     * Only when built with LCD_I2C_BUFFER_POOL. Set it before constructing the displays.
+     * A display which finds the pool empty sends each command at once until a buffer is free.
+     * 
+     * @param pool The shared pool
+     */
+    static void setBufferPool(LCD_BufferPool *pool) noexcept;
+    #endif
+    ///@}
     #ifdef ARDUINO
     ///@endcond 
     #endif
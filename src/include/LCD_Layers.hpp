@@ -0,0 +1,164 @@
+/**
+ * @file LCD_Layers.hpp
+ * @author Keith Standiford
+ * @brief A base screen with pop-up layers over it
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022 Keith Standiford. All rights reserved.
+ * @remark Compiles for Arduino or for Pi Pico
+ *
+ */
+#pragma once
+
+#ifdef ARDUINO
+#include "LCD_I2C.h"
+#else
+#include <string.h>
+#include <hardware/i2c.h>
+#include <LCD_I2C.hpp>
+#endif
+
+/**
+ * @brief A base screen with a stack of pop-ups (warnings, confirmations) drawn over it.
+ *
+ * The base screen and each pop-up are kept in RAM, and refresh() sends the changes to what the
+ * display should show: in each cell, the top pop-up covering it, or the base screen.
+ * A record of what the display holds means only changed cells are ever sent.
+ *
+ * So showing a pop-up sends just the pop-up. Dismissing it with pop() sends just the cells it
+ * covered, and only those where the base screen differs. The base screen can be written while
+ * a pop-up is up. Changes underneath it are kept, not sent, and appear when it goes away.
+ *
+ * The text of a pop-up is kept in storage supplied by the caller, width x height characters.
+ * Positions given to writePopup() are inside the pop-up.
+ *
+ * @code
+ * LCD_Layers screen(lcd);
+ * screen.write(0, 0, "Temp  21.5 C");
+ * screen.refresh();
+ * static char box[3 * 14];
+ * screen.push(1, 3, 14, 3, box);
+ * screen.writePopup(1, 1, "Door open!");
+ * screen.refresh();                       // sends the pop-up
+ * screen.write(0, 6, "21.7");             // sent now, it is not covered
+ * screen.pop();
+ * screen.refresh();                       // sends what the pop-up covered
+ * @endcode
+ *
+ * @note Line and position are in the *same* order on Arduino and Pi Pico.
+ */
+class LCD_Layers {
+ public:
+
+    using byte = uint8_t;
+
+    /** @brief The most pop-ups which can be up at once */
+    static constexpr byte MAX_POPUPS = 4;
+
+    /**
+     * @brief Construct the layers with a blank base screen. Nothing is sent to the display.
+     *
+     * The display is assumed blank. Call redraw() if it might not be.
+     *
+     * @param lcd The display to draw on
+     */
+    LCD_Layers(LCD_I2C &lcd) noexcept;
+
+    /**
+     * @brief Write a string to the base screen. Nothing is sent until refresh().
+     *
+     * @param line The row (or line)
+     * @param position The position (or column)
+     * @param text The string, clipped at the right edge of the screen
+     */
+    void write(byte line, byte position, const char text[]) noexcept;
+
+    /**
+     * @brief Write a character to the base screen. Nothing is sent until refresh().
+     *
+     * @param line The row (or line)
+     * @param position The position (or column)
+     * @param c The character
+     */
+    void writeChar(byte line, byte position, char c) noexcept;
+
+    /**
+     * @brief Fill the base screen with blanks. Nothing is sent until refresh().
+     */
+    void clear(void) noexcept;
+
+    /**
+     * @brief Put up a blank pop-up over everything else. Nothing is sent until refresh().
+     *
+     * @param line The row (or line) of its top left cell
+     * @param position The position (or column) of its top left cell
+     * @param width The width, clipped at the right edge of the screen
+     * @param height The height, clipped at the bottom of the screen
+     * @param storage The pop-up's text, at least width x height characters
+     * @return (bool) False if there are already MAX_POPUPS pop-ups
+     */
+    bool push(byte line, byte position, byte width, byte height, char storage[]) noexcept;
+
+    /**
+     * @brief Take down the top pop-up. Nothing is sent until refresh().
+     */
+    void pop(void) noexcept;
+
+    /** @brief The number of pop-ups up */
+    inline byte popups(void) const noexcept
+    { return _count; }
+
+    /**
+     * @brief Write a string into the top pop-up. Nothing is sent until refresh().
+     *
+     * @param line The row (or line) inside the pop-up
+     * @param position The position (or column) inside the pop-up
+     * @param text The string, clipped at the right edge of the pop-up
+     */
+    void writePopup(byte line, byte position, const char text[]) noexcept;
+
+    /**
+     * @brief Send the cells which differ from what the display holds.
+     *
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display.
+     * @return (int) The number of characters sent
+     */
+    int refresh(bool Enable_Buffering = false) noexcept;
+
+    /**
+     * @brief Send every cell again, for example after something else wrote to the display.
+     *
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display.
+     * @return (int) The number of characters sent
+     */
+    int redraw(bool Enable_Buffering = false) noexcept;
+
+ private:
+
+    static constexpr byte MAX_LINES = 4;
+    static constexpr byte MAX_CHARS = 20;
+
+    struct Popup {
+        byte line;
+        byte position;
+        byte width;
+        byte height;
+        char *text;
+    };
+
+    LCD_I2C &_lcd;
+    byte _rows;
+    byte _columns;
+    char _base[MAX_LINES][MAX_CHARS];
+    byte _shown[MAX_LINES][MAX_CHARS];    // what the display holds
+    Popup _popup[MAX_POPUPS];
+    byte _count = 0;
+
+    // What the display should show on a line: the base with the pop-ups over it
+    void compose(byte line, byte data[]) const noexcept;
+};
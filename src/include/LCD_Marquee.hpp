@@ -0,0 +1,111 @@
+/**
+ * @file LCD_Marquee.hpp
+ * @author Keith Standiford
+ * @brief A scrolling marquee using the display's hardware shift, for the Fast LCD I2C driver
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022 Keith Standiford. All rights reserved.
+ * @remark Compiles for Arduino or for Pi Pico
+ *
+ */
+#pragma once
+
+#ifdef ARDUINO
+#include "LCD_I2C.h"
+#else
+#include <string.h>
+#include <hardware/i2c.h>
+#include <LCD_I2C.hpp>
+#endif
+
+/**
+ * @brief A message scrolling continuously from right to left across one line.
+ *
+ * The display controller holds 40 characters per line, but a 16 or 20 column screen only shows
+ * part of them. The marquee preloads the whole display RAM line and then moves the text with
+ * the display shift command, which costs 4 or 5 bytes per step instead of rewriting the line.
+ * The hidden part of the line is refilled a few characters at a time as the text wraps 
+ * through, and characters which are already correct are not sent again. A message of up 
+ * to 40 characters (including the gap) never needs refilling at all.
+ *
+ * @note The display shift moves *every* line of the screen, so any other line scrolls along
+ * with the marquee. home() (or stop()) puts the screen back.
+ *
+ * @note On four line displays, lines 0 and 2 (and lines 1 and 3) share a display RAM line, so
+ * there is no hidden part to work with. There the marquee rewrites the characters which
+ * change on the line instead, without using the display shift.
+ *
+ * @note The text is not copied, so it must not go away while the marquee is running.
+ */
+class LCD_Marquee {
+ public:
+
+    using byte = uint8_t;
+
+    /**
+     * @brief Construct a marquee. Nothing is sent to the display.
+     *
+     * @param lcd The display to draw on
+     * @param line The row (or line) to scroll the text on
+     * @param gap The number of blanks between the end of the text and its next repeat
+     * @param refill The number of hidden characters to refill at once. Larger values
+     * save address commands, smaller values spread the traffic more evenly over the steps.
+     */
+    LCD_Marquee(LCD_I2C &lcd, byte line, byte gap = 4, byte refill = 8) noexcept;
+
+    /**
+     * @brief Start scrolling a message.
+     *
+     * The display is sent home() to remove any shift, and the display RAM line is
+     * loaded with the beginning of the message.
+     *
+     * @param text The message. It is not copied!
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display.
+     */
+    void start(const char text[], bool Enable_Buffering = false) noexcept;
+
+    /**
+     * @brief Scroll the message one character to the left.
+     *
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display.
+     */
+    void step(bool Enable_Buffering = false) noexcept;
+
+    /**
+     * @brief Stop scrolling and remove the display shift with home().
+     */
+    void stop(void) noexcept;
+
+    /**
+     * @brief The number of steps since start()
+     */
+    inline uint32_t steps(void) const noexcept
+    { return _offset; }
+
+ private:
+
+    static constexpr byte RAM_LENGTH = LCD_I2C::DDRAM_LINE_LENGTH;
+
+    LCD_I2C &_lcd;
+    byte _line;
+    byte _gap;
+    byte _refill;
+    bool _hardware;         // true when the display shift can be used
+    const char *_text = NULL;
+    size_t _length = 0;
+    size_t _period = 1;     // text plus gap
+    uint32_t _offset = 0;   // the character of the message at the left edge of the screen
+    uint32_t _valid = 0;    // the display RAM holds the message up to (not including) here
+    byte _shown[RAM_LENGTH];    // what the display RAM line holds
+
+    // The character at a position in the endless message
+    byte at(uint32_t index) const noexcept;
+
+    // Load the display RAM with the message from _valid up to end
+    void load(uint32_t end) noexcept;
+};
@@ -0,0 +1,185 @@
+/**
+ * @file LCD_Screen.hpp
+ * @author Keith Standiford
+ * @brief Screen layouts encoded when the program is compiled
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022 Keith Standiford. All rights reserved.
+ * @remark Header only. Needs C++14 or later; otherwise it is empty.
+ *
+ */
+#pragma once
+
+#include <string.h>
+#include <LCD_I2C.hpp>
+
+#if __cplusplus >= 201402L
+
+/**
+ * @brief A screen of fixed labels with slots for the values which change.
+ *
+ * The layout is written as the text of each row. Runs of the slot character (an
+ * underscore unless you choose another) mark the fields. Everything else is label text.
+ * Declared `static constexpr`, the labels are encoded for the bus when the program is
+ * compiled and stored in flash, ready to send:
+ *
+ * @code
+ * enum MainFields { TEMP, FAN };
+ * static constexpr LCD_Screen<4, 20> MAIN({
+ *     "Temp: _____ C",
+ *     "Fan:  ____ rpm",
+ *     "",
+ *     "        Menu  Back"});
+ *
+ * MAIN.paint(lcd);                         // clear, then one copy of the labels
+ * MAIN.writeField(lcd, TEMP, "21.5");      // padded with spaces to the field width
+ * @endcode
+ *
+ * paint() clears the display and sends only the label text. Blank cells and the fields
+ * are left to the clear. Labels separated by a single space are sent as one run, since
+ * the space is cheaper than moving the cursor.
+ *
+ * Fields are numbered in reading order, left to right and top to bottom. An enum makes
+ * a good set of names for them.
+ *
+ * @note Line and position are in the *same* order on Arduino and Pi Pico.
+ *
+ * @tparam ROWS The number of rows (lines) on the display
+ * @tparam COLS The number of columns on the display
+ * @tparam MAX_FIELDS The most fields the screen can have
+ */
+template <uint8_t ROWS, uint8_t COLS, uint8_t MAX_FIELDS = 8>
+class LCD_Screen {
+ public:
+
+    using byte = uint8_t;
+
+    /** @brief Where a field is on the screen */
+    struct Field {
+        byte line;          ///< The row (or line) of the first cell
+        byte position;      ///< The position (or column) of the first cell
+        byte width;         ///< The number of cells
+    };
+
+    /**
+     * @brief The most bytes the labels can need.
+     *
+     * Each cell costs 4 bytes. Each run of label text also costs a mode byte, the
+     * cursor command and another mode byte, and runs are at least 2 cells apart.
+     */
+    static constexpr size_t MAX_WIRE = ROWS * (4 * COLS + 6 * ((COLS + 1) / 2));
+
+    /**
+     * @brief Build the screen from the text of its rows.
+     *
+     * @param rows The text of each row. Shorter rows are blank to the right.
+     * @param slot The character which marks the cells of the fields
+     */
+    constexpr LCD_Screen(const char *const (&rows)[ROWS], char slot = '_') noexcept
+    {
+        for(byte line = 0; line < ROWS; line++) {
+            const char *text = rows[line];
+            byte length = 0;
+            while(length < COLS && text[length]) length++;
+
+            byte col = 0;
+            while(col < length) {
+                if(text[col] == slot) {             // a field
+                    byte start = col;
+                    while(col < length && text[col] == slot) col++;
+                    if(_fieldCount < MAX_FIELDS)
+                        _fields[_fieldCount++] = Field{line, start, (byte)(col - start)};
+                } else if(text[col] == ' ') {
+                    col++;
+                } else {                            // a run of label text
+                    byte start = col;
+                    byte end = col;                 // one past the last label character
+                    while(col < length) {
+                        if(text[col] != ' ' && text[col] != slot) end = ++col;
+                        else if(text[col] == ' ' && col + 1 < length && text[col + 1] != ' '
+                                && text[col + 1] != slot) col++;    // one space is cheaper
+                        else break;
+                    }
+                    col = end;
+                    _wire[_length++] = LCD_I2C::encodeMode(true);
+                    LCD_I2C::encodeByte(LCD_I2C::addressCommand(line, start), true, &_wire[_length]);
+                    _length += 4;
+                    _wire[_length++] = LCD_I2C::encodeMode(false);
+                    for(byte i = start; i < end; i++, _length += 4)
+                        LCD_I2C::encodeByte((byte)text[i], false, &_wire[_length]);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Clear the display and draw the labels. The fields are left blank.
+     *
+     * @param lcd The display
+     * @param Enable_Buffering If true, the labels are simply added to the output buffer.
+     * If false or missing, they are added to the output buffer and the buffer
+     * is immediately written to the display. (The clear is always sent at once.)
+     */
+    inline void paint(LCD_I2C &lcd, bool Enable_Buffering = false) const noexcept
+    {
+        lcd.clear();
+        drawLabels(lcd, Enable_Buffering);
+    }
+
+    /**
+     * @brief Draw the labels without clearing, for example over a screen with the same blanks.
+     *
+     * @param lcd The display
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display.
+     */
+    inline void drawLabels(LCD_I2C &lcd, bool Enable_Buffering = false) const noexcept
+    { lcd.sendEncoded(_wire, _length, Enable_Buffering); }
+
+    /**
+     * @brief Write text into a field, padded with spaces or cut to the field width
+     *
+     * @param lcd The display
+     * @param field The number of the field
+     * @param text The text to show
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display.
+     */
+    void writeField(LCD_I2C &lcd, byte field, const char *text, bool Enable_Buffering = false) const noexcept
+    {
+        if(field >= _fieldCount) return;
+        const Field &f = _fields[field];
+        size_t length = text ? strlen(text) : 0;
+        if(length > f.width) length = f.width;
+        LCD_I2C::Guard guard(lcd);          // keep the field together
+        lcd.setAddress(f.line, f.position, true);
+        lcd.write(text, length, true);
+        for(size_t i = length; i < f.width; i++)
+            lcd.writeChar(' ', true);
+        if(!Enable_Buffering) lcd.show();
+    }
+
+    /** @brief The place of a field on the screen */
+    inline constexpr const Field &field(byte field) const noexcept
+    { return _fields[field]; }
+
+    /** @brief The number of fields */
+    inline constexpr byte fields(void) const noexcept
+    { return _fieldCount; }
+
+    /** @brief The number of bytes sent by drawLabels() */
+    inline constexpr size_t size(void) const noexcept
+    { return _length; }
+
+ private:
+
+    byte _wire[MAX_WIRE] {};
+    size_t _length = 0;
+    Field _fields[MAX_FIELDS] {};
+    byte _fieldCount = 0;
+};
+
+#endif
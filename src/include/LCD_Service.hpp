@@ -0,0 +1,187 @@
+/**
+ * @file LCD_Service.hpp
+ * @author Keith Standiford
+ * @brief Drive the display from the second core of the Pi Pico through a command queue
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022 Keith Standiford. All rights reserved.
+ * @remark Pi Pico only
+ *
+ */
+#pragma once
+
+#include <string.h>
+#include <atomic>
+#include <hardware/i2c.h>
+#include <hardware/sync.h>
+#include <LCD_I2C.hpp>
+
+/**
+ * @brief A display service which lets one core write to the display while the other core
+ * does all the work.
+ *
+ * The producer (usually core 0) calls the familiar functions, such as setCursor() and
+ * writeString(). They do not touch the display or the I2C bus. Each call just copies a short
+ * command into a lock-free, single producer single consumer ring buffer and returns. The 
+ * consumer (usually core 1) runs service() or run(), which takes the commands out of the
+ * queue, makes the I2C bytes and sends them, and does the waiting for clear() and home().
+ *
+ * A command is a one byte code, its arguments, and for text, a length and the characters.
+ * Queueing setCursor() costs a few tens of cycles, and text costs about one more cycle per character.
+ * If a whole command does not fit in the queue, it is dropped (never partly queued), the call
+ * returns false and the drop is counted. depth(), highWater() and dropped() show how the queue is doing.
+ *
+ * @code
+ * static uint8_t queue[1024];
+ * static LCD_Service service(lcd, queue, sizeof(queue));
+ * void core1_main(void) { service.run(); }
+ * ...
+ * multicore_launch_core1(core1_main);
+ * service.setCursor(0, 0);
+ * service.writeString("Hello from core 0");
+ * @endcode
+ *
+ * @note Once the service is running, the display belongs to the consumer. Only the producer
+ * may queue commands, and only the consumer may use the display.
+ * @note The queue storage is supplied by the caller. Its size is rounded down to a power of 2.
+ */
+class LCD_Service {
+ public:
+
+    using byte = uint8_t;
+
+    /**
+     * @brief Construct a display service. Nothing is sent to the display.
+     *
+     * @param lcd The display to drive
+     * @param queue The storage for the command queue
+     * @param size The size of the queue storage in bytes, rounded down to a power of 2.
+     * A command takes 1 to 3 bytes, plus its text or character map. With 0, every command is dropped.
+     */
+    LCD_Service(LCD_I2C &lcd, byte queue[], size_t size) noexcept;
+
+    /** @name Producer Functions
+     * 
+     * These queue a command for the consumer and return at once. Each returns false if the
+     * command did not fit in the queue and was dropped.
+     */
+    ///@{
+
+    /** @brief Queue clear() */
+    bool clear(void) noexcept;
+    /** @brief Queue home() */
+    bool home(void) noexcept;
+    /** @brief Queue setCursor() */
+    bool setCursor(byte line, byte position) noexcept;
+    /** @brief Queue setAddress() */
+    bool setAddress(byte line, byte position) noexcept;
+    /** 
+     * @brief Queue writeString(). The characters are copied into the queue.
+     * Strings longer than 255 characters are queued as several commands. 
+     */
+    bool writeString(const char s[]) noexcept;
+    /** @brief Queue writeChar() */
+    bool writeChar(byte c) noexcept;
+    /** @brief Queue write() of size characters. The characters are copied into the queue. */
+    bool write(const byte buffer[], size_t size) noexcept;
+    /** @brief Queue createChar(). The character map is copied into the queue. */
+    bool createChar(byte charnum, const byte char_map[]) noexcept;
+    /** @brief Queue backlight() */
+    bool backlight(void) noexcept;
+    /** @brief Queue noBacklight() */
+    bool noBacklight(void) noexcept;
+    /** @brief Queue display() */
+    bool display(void) noexcept;
+    /** @brief Queue noDisplay() */
+    bool noDisplay(void) noexcept;
+    /** @brief Queue cursor() */
+    bool cursor(void) noexcept;
+    /** @brief Queue noCursor() */
+    bool noCursor(void) noexcept;
+    /** @brief Queue blink() */
+    bool blink(void) noexcept;
+    /** @brief Queue noBlink() */
+    bool noBlink(void) noexcept;
+    /** @brief Queue scrollDisplayLeft() */
+    bool scrollDisplayLeft(void) noexcept;
+    /** @brief Queue scrollDisplayRight() */
+    bool scrollDisplayRight(void) noexcept;
+    ///@}
+
+    /** @name Consumer Functions
+     */
+    ///@{
+
+    /**
+     * @brief Carry out the queued commands, and show() the result once the queue is empty.
+     *
+     * @param max_commands The most commands to carry out before returning (0 for no limit)
+     * @return (int) The number of commands carried out
+     */
+    int service(int max_commands = 0) noexcept;
+
+    /**
+     * @brief Serve the queue forever, sleeping (with __wfe()) whenever it is empty.
+     * This never returns, and is usually the main function of core 1.
+     */
+    [[noreturn]] void run(void) noexcept;
+    ///@}
+
+    /** @name Queue Statistics
+     */
+    ///@{
+
+    /** @brief The number of bytes waiting in the queue */
+    inline size_t depth(void) const noexcept
+    { return _head.load(std::memory_order_relaxed) - _tail.load(std::memory_order_relaxed); }
+
+    /** @brief The size of the queue in bytes */
+    inline size_t capacity(void) const noexcept
+    { return _queue ? _mask + 1 : 0; }
+
+    /** @brief The largest depth seen since the statistics were reset */
+    inline size_t highWater(void) const noexcept
+    { return _highWater; }
+
+    /** @brief The number of commands dropped since the statistics were reset */
+    inline uint32_t dropped(void) const noexcept
+    { return _dropped; }
+
+    /** @brief Reset highWater() and dropped(). Call from the producer. */
+    inline void resetStatistics(void) noexcept
+    { _highWater = 0; _dropped = 0; }
+    ///@}
+
+ private:
+
+    enum Op : byte {
+        OP_CLEAR, OP_HOME, OP_SET_CURSOR, OP_SET_ADDRESS, OP_TEXT, OP_CREATE_CHAR,
+        OP_BACKLIGHT, OP_NO_BACKLIGHT, OP_DISPLAY, OP_NO_DISPLAY, OP_CURSOR, OP_NO_CURSOR,
+        OP_BLINK, OP_NO_BLINK, OP_SCROLL_LEFT, OP_SCROLL_RIGHT
+    };
+
+    static constexpr size_t MAX_TEXT = 255;     // one length byte
+
+    LCD_I2C &_lcd;
+    byte *_queue;
+    uint32_t _mask;
+
+    // Free running indices. Only the producer writes _head, only the consumer writes _tail.
+    std::atomic<uint32_t> _head {0};
+    std::atomic<uint32_t> _tail {0};
+
+    // Written only by the producer
+    volatile uint32_t _highWater = 0;
+    volatile uint32_t _dropped = 0;
+
+    // Queue a command with up to 2 arguments followed by length bytes of data
+    bool put(byte op, byte arg_count, byte arg0 = 0, byte arg1 = 0,
+            const byte *data = nullptr, size_t length = 0) noexcept;
+
+    // Copy length bytes out of the queue at index
+    void get(uint32_t index, byte *dest, size_t length) const noexcept;
+
+    inline byte at(uint32_t index) const noexcept
+    { return _queue[index & _mask]; }
+};
@@ -0,0 +1,189 @@
+/**
+ * @file LCD_UpdateQueue.hpp
+ * @author Keith Standiford
+ * @brief Lock-free display updates from many tasks and interrupt handlers
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022 Keith Standiford. All rights reserved.
+ * @remark Pi Pico only
+ *
+ */
+#pragma once
+
+#include <string.h>
+#include <atomic>
+#include <hardware/i2c.h>
+#include <LCD_I2C.hpp>
+
+/**
+ * @brief Collects updates to fields of the display from many producers (tasks, interrupt 
+ * handlers or the other core), and sends them from one consumer.
+ *
+ * Each field of the display is a preallocated Field node, with storage supplied by the caller.
+ * A producer posts new text to its field with Field::post(). This never waits, never locks and
+ * never uses the heap, so it is safe in interrupt handlers: the text is copied into the field
+ * under a sequence counter and the field is flagged as pending. (The RP2040 has no atomic
+ * read-modify-write instructions, so only plain atomic loads and stores are used.)
+ *
+ * The consumer calls service(). It takes the latest text of each pending field, so any number
+ * of posts between two calls cost only one update, and sends only the characters which differ
+ * from what the field shows. If a producer was part way through a post, that field is simply
+ * left pending until the next call.
+ *
+ * When the bus can not keep up, schedule() sends only as many fields as fit in a byte budget
+ * (a bus slot), most urgent first. Each field has a priority and a maximum age: a higher priority
+ * always goes first, so an alarm's latency does not depend on how busy the other fields are,
+ * and fields of the same priority are sent earliest deadline first. Fields which do not fit
+ * wait for the next slot, so the lowest priority fields are the ones which fall behind.
+ *
+ * @note Each field must have only one producer at a time. Different fields may be posted
+ * from anywhere at once.
+ * @note Fields are attached before the producers start, and only the consumer uses the display.
+ */
+class LCD_UpdateQueue {
+ public:
+
+    using byte = uint8_t;
+
+    /** @brief The widest field */
+    static constexpr byte MAX_WIDTH = LCD_I2C::DDRAM_LINE_LENGTH;
+
+    /**
+     * @brief A preallocated field of the display which producers post text to.
+     */
+    class Field {
+     public:
+        /**
+         * @brief Construct a field. Nothing is sent to the display.
+         *
+         * @param line The row (or line) of the field
+         * @param position The position (or column) of the left end of the field
+         * @param width The width of the field, at most 40
+         * @param storage Storage for the field, at least 2 x width bytes
+         * @param priority The priority of the field. Higher priorities are sent first.
+         * @param max_age_us How soon a new post should be shown, in microseconds (0 for no deadline)
+         */
+        Field(byte line, byte position, byte width, byte storage[],
+                byte priority = 0, uint32_t max_age_us = 0) noexcept;
+
+        /**
+         * @brief Post new text for the field. Never waits, and is safe in interrupt handlers.
+         *
+         * The text is clipped or padded with blanks to the width of the field.
+         *
+         * @param text The new text
+         */
+        void post(const char text[]) noexcept;
+
+        /**
+         * @brief Post new characters for the field. Never waits, and is safe in interrupt handlers.
+         *
+         * @param data The new characters
+         * @param length The number of characters. The field is padded with blanks.
+         */
+        void post(const byte data[], byte length) noexcept;
+
+        /** @brief The number of times the field has been posted */
+        inline uint32_t posts(void) const noexcept
+        { return _seq.load(std::memory_order_relaxed) / 2; }
+
+     private:
+        friend class LCD_UpdateQueue;
+
+        byte _line;
+        byte _position;
+        byte _width;
+        byte *_posted;                  // the latest text, written by the producer
+        byte *_shown;                   // what the display shows, used by the consumer
+        std::atomic<uint32_t> _seq {0}; // odd while the producer is writing
+        std::atomic<bool> _pending {false};
+        bool _stale = true;             // the consumer must send the whole field
+        byte _priority;
+        uint32_t _maxAge;
+        volatile uint32_t _since = 0;   // when the oldest unsent post was made
+        uint32_t _round = 0;            // the consumer's last schedule() to look at the field
+        LCD_UpdateQueue *_queue = nullptr;
+        Field *_next = nullptr;
+    };
+
+    /**
+     * @brief Construct an update queue for a display. Nothing is sent to the display.
+     *
+     * @param lcd The display to update
+     */
+    LCD_UpdateQueue(LCD_I2C &lcd) noexcept;
+
+    /**
+     * @brief Attach a field to the queue. The field is shown as blank until it is posted.
+     *
+     * Attach all the fields before the producers start posting.
+     *
+     * @param field The field
+     */
+    void attach(Field &field) noexcept;
+
+    /**
+     * @brief Send the pending fields. Call from the consumer only.
+     *
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display.
+     * @return (int) The number of characters sent
+     */
+    int service(bool Enable_Buffering = false) noexcept;
+
+    /**
+     * @brief Send the most urgent pending fields which fit in a byte budget. Call from the consumer only.
+     *
+     * Fields are taken highest priority first, and earliest deadline first within a priority,
+     * until the next one would go over max_bytes. Fields which do not fit stay pending. 
+     * The most urgent field is always sent, even if it alone is over the budget.
+     *
+     * @param max_bytes The byte budget for this call (the bus slot)
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display.
+     * @return (int) The number of characters sent
+     */
+    int schedule(size_t max_bytes, bool Enable_Buffering = false) noexcept;
+
+    /**
+     * @brief Send every field again at the next service(), for example after the screen was cleared.
+     * Call from the consumer only.
+     */
+    void redraw(void) noexcept;
+
+    /** @brief True if any field has been posted since the last service() */
+    inline bool pending(void) const noexcept
+    { return _pending.load(std::memory_order_relaxed); }
+
+    /** @brief The number of field updates sent */
+    inline uint32_t updates(void) const noexcept
+    { return _updates; }
+
+    /** @brief The number of times a field was caught part way through a post and retried */
+    inline uint32_t retries(void) const noexcept
+    { return _retries; }
+
+    /** @brief The number of field updates sent after their deadline */
+    inline uint32_t late(void) const noexcept
+    { return _late; }
+
+    /** @brief The number of times a pending field was left for a later slot */
+    inline uint32_t deferred(void) const noexcept
+    { return _deferred; }
+
+ private:
+
+    static constexpr uint32_t NO_DEADLINE_US = 1u << 30;   // about 18 minutes
+
+    LCD_I2C &_lcd;
+    Field *_fields = nullptr;
+    std::atomic<bool> _pending {false};  // set by producers after flagging a field
+    uint32_t _updates = 0;
+    uint32_t _retries = 0;
+    uint32_t _late = 0;
+    uint32_t _deferred = 0;
+    uint32_t _round = 0;
+};
@@ -0,0 +1,145 @@
+/**
+ * @file LCD_VirtualScreen.hpp
+ * @author Keith Standiford
+ * @brief A virtual screen larger than the display, with a movable viewport
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022 Keith Standiford. All rights reserved.
+ * @remark Compiles for Arduino or for Pi Pico
+ *
+ */
+#pragma once
+
+#ifdef ARDUINO
+#include "LCD_I2C.h"
+#else
+#include <string.h>
+#include <hardware/i2c.h>
+#include <LCD_I2C.hpp>
+#endif
+
+/**
+ * @brief A text surface up to 40 columns wide and any number of lines high, seen through
+ * a viewport the size of the screen.
+ *
+ * Text is written to the virtual screen in RAM (the storage is supplied by the caller), and 
+ * refresh() sends the changes. The virtual screen keeps a record of what the display holds,
+ * so only the characters which differ are ever sent. Paging up or down only sends the
+ * characters of the newly exposed lines which are not already there.
+ * 
+ * On one and two line displays, each line of the viewport is kept in its own 40 character
+ * display RAM line, and panning left or right uses the display shift command. Panning
+ * one column costs 4 or 5 bytes for the whole screen, plus any newly exposed characters
+ * which had not been loaded yet. (On four line displays, the display RAM lines are shared
+ * by two screen lines, so panning rewrites the changed characters instead.)
+ *
+ * @note The display shift moves the cursor positions too. Other code writing to the
+ * display while a virtual screen is panned should use setAddress() with the shifted position.
+ */
+class LCD_VirtualScreen {
+ public:
+
+    using byte = uint8_t;
+
+    /** @brief The widest virtual screen (one display RAM line) */
+    static constexpr byte MAX_WIDTH = LCD_I2C::DDRAM_LINE_LENGTH;
+
+    /**
+     * @brief Construct a virtual screen filled with blanks. Nothing is sent to the display.
+     *
+     * @param lcd The display to draw on
+     * @param storage The text storage, at least width x height characters
+     * @param width The width of the virtual screen, at most 40
+     * @param height The number of lines in the virtual screen
+     */
+    LCD_VirtualScreen(LCD_I2C &lcd, char storage[], byte width, byte height) noexcept;
+
+    /**
+     * @brief Clear the display and show the virtual screen with the viewport at the top left.
+     *
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display.
+     */
+    void begin(bool Enable_Buffering = false) noexcept;
+
+    /**
+     * @brief Fill the virtual screen with blanks. Nothing is sent until refresh().
+     */
+    void clear(void) noexcept;
+
+    /**
+     * @brief Write a string to the virtual screen. Nothing is sent until refresh().
+     *
+     * The string is clipped at the right edge of the virtual screen.
+     *
+     * @param line The line of the virtual screen
+     * @param position The position on the line
+     * @param text The string to write
+     */
+    void write(byte line, byte position, const char text[]) noexcept;
+
+    /**
+     * @brief Write a character to the virtual screen. Nothing is sent until refresh().
+     *
+     * @param line The line of the virtual screen
+     * @param position The position on the line
+     * @param c The character to write
+     */
+    void writeChar(byte line, byte position, char c) noexcept;
+
+    /**
+     * @brief Read a character back from the virtual screen
+     *
+     * @param line The line of the virtual screen
+     * @param position The position on the line
+     * @return (char) The character, or a blank if outside the virtual screen
+     */
+    char charAt(byte line, byte position) const noexcept;
+
+    /**
+     * @brief Move the viewport. Nothing is sent until refresh().
+     *
+     * The viewport is kept inside the virtual screen.
+     *
+     * @param top The virtual screen line shown on the top line of the display
+     * @param left The virtual screen position shown in the left column of the display
+     */
+    void setViewport(byte top, byte left) noexcept;
+
+    /** @brief The virtual screen line shown on the top line of the display */
+    inline byte top(void) const noexcept
+    { return _top; }
+
+    /** @brief The virtual screen position shown in the left column of the display */
+    inline byte left(void) const noexcept
+    { return _left; }
+
+    /**
+     * @brief Send the changes in the viewport to the display.
+     *
+     * @param Enable_Buffering If true, the data is simply added to the output buffer.
+     * If false or missing, data is added to the output buffer and the buffer
+     * is immediately written to the display.
+     * @return (int) The number of characters sent
+     */
+    int refresh(bool Enable_Buffering = false) noexcept;
+
+ private:
+
+    static constexpr byte MAX_LINES = 4;
+
+    LCD_I2C &_lcd;
+    char *_text;
+    byte _width;
+    byte _height;
+    byte _top = 0;
+    byte _left = 0;
+    bool _hardware;     // true when panning uses the display shift
+    byte _shift = 0;    // the display shift, in positions to the left
+
+    // What the display RAM holds. For the display shift, each screen line has a
+    // whole display RAM line. Otherwise only the visible part is used.
+    byte _shown[MAX_LINES][MAX_WIDTH];
+};
@@ -0,0 +1,9 @@
+/*
+ * Host stand-in for the Pico SDK GPIO functions. They do nothing.
+ */
+#pragma once
+#include <pico/stdlib.h>
+
+#define GPIO_FUNC_I2C 3
+static inline void gpio_set_function(uint gpio, int function) { (void) gpio; (void) function; }
+static inline void gpio_pull_up(uint gpio) { (void) gpio; }
@@ -0,0 +1,22 @@
+/*
+ * Host stand-in for the Pico SDK I2C driver. Writes go to the recording transport in host.cpp.
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <pico/stdlib.h>
+
+typedef struct i2c_inst { int index; } i2c_inst_t;
+extern i2c_inst_t i2c0_inst, i2c1_inst;
+#define i2c0 (&i2c0_inst)
+#define i2c1 (&i2c1_inst)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+#ifdef __cplusplus
+}
+#endif
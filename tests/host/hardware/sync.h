@@ -0,0 +1,31 @@
+/*
+ * Host stand-in for the RP2040 spin locks. Each is a std::mutex, and get_core_num() is
+ * whatever the thread set host_core to.
+ */
+#pragma once
+#include <stdlib.h>
+#include <mutex>
+#include <atomic>
+#include <pico/stdlib.h>
+
+struct spin_lock_t { std::mutex m; };
+
+extern spin_lock_t host_spin_locks[32];
+extern thread_local uint host_core;
+
+static constexpr uint32_t HOST_SAVED_IRQ = 0x5a;
+
+static inline uint get_core_num(void) { return host_core; }
+uint spin_lock_claim_unused(bool required);
+void spin_lock_unclaim(uint lock_num);
+static inline spin_lock_t *spin_lock_instance(uint lock_num) { return &host_spin_locks[lock_num]; }
+static inline uint32_t spin_lock_blocking(spin_lock_t *lock) { lock->m.lock(); return HOST_SAVED_IRQ; }
+static inline void spin_unlock(spin_lock_t *lock, uint32_t saved_irq)
+{
+    if(saved_irq != HOST_SAVED_IRQ) abort();    // the interrupt state was not given back
+    lock->m.unlock();
+}
+static inline void __sev(void) {}
+static inline void __wfe(void) {}
+static inline void __dmb(void) { std::atomic_thread_fence(std::memory_order_seq_cst); }
+static inline void tight_loop_contents(void) {}
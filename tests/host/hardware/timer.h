@@ -0,0 +1,8 @@
+/*
+ * Host stand-in for the Pico SDK timer. Time is simulated, see host.hpp.
+ */
+#pragma once
+#include <pico/stdlib.h>
+
+static inline void busy_wait_us(uint64_t us) { sleep_us(us); }
+static inline void busy_wait_us_32(uint32_t us) { sleep_us(us); }
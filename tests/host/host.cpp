@@ -0,0 +1,149 @@
+/*
+ * The host side of the tests. See host.hpp.
+ */
+#include <stdio.h>
+#include <mutex>
+#include <hardware/i2c.h>
+#include <hardware/sync.h>
+#include <pico/time.h>
+#include "host.hpp"
+
+std::atomic<uint64_t> host_time {0};
+std::atomic<uint32_t> host_us_per_byte {90};
+std::atomic<bool> host_nak {false};
+std::atomic<long> host_collisions {0};
+std::atomic<long> host_alarm_sleeps {0};
+
+i2c_inst_t i2c0_inst = {0}, i2c1_inst = {1};
+spin_lock_t host_spin_locks[32];
+thread_local uint host_core = 0;
+
+static constexpr int MAX_DISPLAYS = 8;
+static struct {
+    i2c_inst_t *i2c;
+    uint8_t address;
+    LCD_Model model;
+} displays[MAX_DISPLAYS];
+static int display_count = 0;
+static std::mutex display_mutex;
+static std::atomic<int> busy[2];        // writes in progress on each bus
+
+static thread_local bool in_alarm = false;
+static struct {
+    alarm_id_t id;
+    uint64_t at;
+    alarm_callback_t callback;
+    void *user_data;
+} alarm = {0, 0, nullptr, nullptr};
+static alarm_id_t next_alarm = 1;
+
+static int failures = 0;
+
+LCD_Model &host_display(uint8_t address, i2c_inst_t *i2c)
+{
+    std::lock_guard<std::mutex> guard(display_mutex);
+    for(int i = 0; i < display_count; i++)
+        if(displays[i].i2c == i2c && displays[i].address == address) return displays[i].model;
+    if(display_count == MAX_DISPLAYS) abort();
+    displays[display_count].i2c = i2c;
+    displays[display_count].address = address;
+    displays[display_count].model.reset();
+    return displays[display_count++].model;
+}
+
+void host_reset(void)
+{
+    std::lock_guard<std::mutex> guard(display_mutex);
+    display_count = 0;
+    host_time = 0;
+    host_us_per_byte = 90;
+    host_nak = false;
+    host_collisions = 0;
+    host_alarm_sleeps = 0;
+    alarm.callback = nullptr;
+}
+
+extern "C" uint i2c_init(i2c_inst_t *i2c, uint baudrate)
+{
+    (void) i2c;
+    return baudrate;
+}
+
+extern "C" int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop)
+{
+    (void) nostop;
+    if(host_nak) return PICO_ERROR_GENERIC;
+    if(busy[i2c->index]++) host_collisions++;
+    LCD_Model &model = host_display(addr, i2c);
+    model.transactions++;
+    for(size_t i = 0; i < len; i++) model.feed(src[i]);
+    host_time += host_us_per_byte * (len + 1);
+    busy[i2c->index]--;
+    return (int) len;
+}
+
+extern "C" uint32_t time_us_32(void) { return (uint32_t) host_time; }
+extern "C" uint64_t time_us_64(void) { return host_time; }
+
+extern "C" void sleep_us(uint64_t us)
+{
+    if(in_alarm) host_alarm_sleeps++;
+    host_time += us;
+}
+
+extern "C" void sleep_ms(uint32_t ms) { sleep_us(ms * 1000ull); }
+
+uint spin_lock_claim_unused(bool required)
+{
+    static std::atomic<uint> next {0};
+    (void) required;
+    return next++ % 32;
+}
+
+void spin_lock_unclaim(uint lock_num) { (void) lock_num; }
+
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past)
+{
+    (void) fire_if_past;
+    alarm.id = next_alarm++;
+    alarm.at = host_time + us;
+    alarm.callback = callback;
+    alarm.user_data = user_data;
+    return alarm.id;
+}
+
+bool cancel_alarm(alarm_id_t alarm_id)
+{
+    if(alarm.callback == nullptr || alarm.id != alarm_id) return false;
+    alarm.callback = nullptr;
+    return true;
+}
+
+void host_run_alarms(void)
+{
+    while(alarm.callback != nullptr && host_time >= alarm.at) {
+        alarm_id_t id = alarm.id;
+        in_alarm = true;
+        int64_t next = alarm.callback(id, alarm.user_data);
+        in_alarm = false;
+        if(alarm.id != id) continue;            // the callback added another
+        if(next == 0) alarm.callback = nullptr;
+        else if(next < 0) alarm.at = host_time - next;
+        else alarm.at += next;
+    }
+}
+
+int host_check(bool ok, const char *what)
+{
+    if(!ok) {
+        printf("FAILED: %s\n", what);
+        failures++;
+    }
+    return ok;
+}
+
+int host_result(void)
+{
+    if(failures == 0) printf("passed\n");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,38 @@
+/*
+ * The host side of the tests: simulated time, a recording I2C transport feeding an
+ * LCD_Model for each address, and alarms which the test fires.
+ */
+#pragma once
+#include <atomic>
+#include <stdint.h>
+#include <hardware/i2c.h>
+#include "lcd_model.hpp"
+
+// Simulated time in microseconds
+extern std::atomic<uint64_t> host_time;
+
+// The time each byte takes on the bus, in microseconds. 90 (100 kHz) unless set.
+extern std::atomic<uint32_t> host_us_per_byte;
+
+// If true, every write fails as if the display were unplugged
+extern std::atomic<bool> host_nak;
+
+// Writes which overlapped another write on the same bus. Always 0 with correct locking.
+extern std::atomic<long> host_collisions;
+
+// Calls to sleep_us() or sleep_ms() from an alarm callback. pico-sdk panics on these.
+extern std::atomic<long> host_alarm_sleeps;
+
+// The model of the display at an address, created the first time
+LCD_Model &host_display(uint8_t address, i2c_inst_t *i2c = i2c0);
+
+// Forget every display and alarm, and start the time again
+void host_reset(void);
+
+// Fire the alarm if it is due, as the timer interrupt would
+void host_run_alarms(void);
+
+// Test helpers
+int host_check(bool ok, const char *what);
+int host_result(void);
+#define CHECK(x) host_check((x), #x)
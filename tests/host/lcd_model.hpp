@@ -0,0 +1,122 @@
+/*
+ * A model of an HD44780 display behind a PCF8574 expander, fed the bytes written to the bus.
+ * It follows the display RAM, character generator RAM, address counter, shift and modes,
+ * so a test can compare what the driver sent with what it meant to show.
+ */
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+struct LCD_Model {
+    static constexpr uint8_t ENABLE = 0x04;
+    static constexpr uint8_t RS = 0x01;
+
+    uint8_t ddram[128];
+    uint8_t cgram[64];
+    int address = 0;            // the address counter
+    bool cgramMode = false;     // the address counter points into CGRAM
+    int shift = 0;              // how far the display is shifted left
+    bool increment = true;
+    bool autoscroll = false;
+    uint8_t control = 0;
+    int rows = 4;
+    int columns = 20;
+
+    long bytes = 0;             // every byte written
+    long transactions = 0;      // every write
+    long characters = 0;
+    long commands = 0;
+
+    LCD_Model() { reset(); }
+
+    void reset(void)
+    {
+        memset(ddram, ' ', sizeof(ddram));
+        memset(cgram, 0, sizeof(cgram));
+        address = shift = 0;
+        cgramMode = autoscroll = false;
+        increment = true;
+        control = 0;
+        _last = 0;
+        _nibble = -1;
+        _fourBit = false;
+        bytes = transactions = characters = commands = 0;
+    }
+
+    // A byte from the expander. Data is latched when enable falls.
+    void feed(uint8_t b)
+    {
+        bytes++;
+        if((_last & ENABLE) && !(b & ENABLE)) {
+            uint8_t nibble = _last >> 4;
+            if(!_fourBit) {                 // the 8 bit commands of the initialization
+                if(nibble == 0x2) _fourBit = true;
+            } else if(_nibble < 0) {
+                _high = nibble;
+                _rs = _last & RS;
+                _nibble = 0;
+            } else {
+                _nibble = -1;
+                execute(_high << 4 | nibble, _rs);
+            }
+        }
+        _last = b;
+    }
+
+    // What a row of the screen shows
+    std::string line(int row) const
+    {
+        static const int offset[4] = {0x00, 0x40, 0x14, 0x54};
+        std::string s;
+        for(int c = 0; c < columns; c++) {
+            int a = rows <= 2 ? (row ? 0x40 : 0) + ((c + shift) % 40 + 40) % 40 : offset[row] + c;
+            s += (char) ddram[a];
+        }
+        return s;
+    }
+
+ private:
+    uint8_t _last;
+    int _nibble;
+    uint8_t _high;
+    bool _rs;
+    bool _fourBit;
+
+    int next(int a) const
+    {
+        a += increment ? 1 : -1;
+        if(a < 0) return 0x67;
+        if(a > 0x67) return 0;
+        if(a > 0x27 && a < 0x40) return increment ? 0x40 : 0x27;
+        return a;
+    }
+
+    void execute(uint8_t v, bool data)
+    {
+        if(data) {
+            characters++;
+            if(cgramMode) {
+                cgram[address & 63] = v;
+                address = (address + (increment ? 1 : -1)) & 63;
+            } else {
+                ddram[address] = v;
+                address = next(address);
+                if(autoscroll) shift += increment ? 1 : -1;
+            }
+            return;
+        }
+        commands++;
+        if(v & 0x80) { cgramMode = false; address = v & 0x7f; }
+        else if(v & 0x40) { cgramMode = true; address = v & 0x3f; }
+        else if(v & 0x20) {}                                        // function set
+        else if(v & 0x10) {
+            if(v & 0x08) shift += v & 0x04 ? -1 : 1;                // display shift
+            else address = next(address);                           // cursor move (approximately)
+        }
+        else if(v & 0x08) control = v;
+        else if(v & 0x04) { increment = v & 0x02; autoscroll = v & 0x01; }
+        else if(v & 0x02) { address = 0; cgramMode = false; shift = 0; }
+        else if(v & 0x01) { memset(ddram, ' ', sizeof(ddram)); address = 0; cgramMode = false; shift = 0; increment = true; }
+    }
+};
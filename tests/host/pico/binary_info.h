@@ -0,0 +1,6 @@
+/*
+ * Host stand-in for the Pico SDK binary info. It records nothing.
+ */
+#pragma once
+
+#define bi_decl(x)
@@ -0,0 +1,17 @@
+/*
+ * Host stand-in for the Pico SDK recursive mutex.
+ */
+#pragma once
+#include <mutex>
+#include <pico/stdlib.h>
+
+struct recursive_mutex_t { std::recursive_mutex m; };
+
+static inline void recursive_mutex_init(recursive_mutex_t *mtx) { (void) mtx; }
+static inline void recursive_mutex_enter_blocking(recursive_mutex_t *mtx) { mtx->m.lock(); }
+static inline bool recursive_mutex_try_enter(recursive_mutex_t *mtx, uint32_t *owner_out)
+{
+    (void) owner_out;
+    return mtx->m.try_lock();
+}
+static inline void recursive_mutex_exit(recursive_mutex_t *mtx) { mtx->m.unlock(); }
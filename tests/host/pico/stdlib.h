@@ -0,0 +1,25 @@
+/*
+ * Host stand-in for the Pico SDK standard library: simulated time and sleeping.
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef unsigned int uint;
+
+#define PICO_ERROR_GENERIC -1
+#define PICO_DEFAULT_I2C 0
+#define PICO_DEFAULT_I2C_SDA_PIN 4
+#define PICO_DEFAULT_I2C_SCL_PIN 5
+#define PICO_DEFAULT_I2C_INSTANCE i2c0
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+uint32_t time_us_32(void);
+uint64_t time_us_64(void);
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,11 @@
+/*
+ * Host stand-in for the Pico SDK alarms. host_run_alarms() fires the ones which are due.
+ */
+#pragma once
+#include <pico/stdlib.h>
+
+typedef int32_t alarm_id_t;
+typedef int64_t (*alarm_callback_t)(alarm_id_t id, void *user_data);
+
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past);
+bool cancel_alarm(alarm_id_t alarm_id);
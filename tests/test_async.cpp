@@ -0,0 +1,107 @@
+/*
+ * Test of the C++20 coroutine interface (LCD_Async) with a simulated clock.
+ *
+ * The executor resumes each coroutine at the time it asked for, moving host_time on as it
+ * goes, so the waits for initialization and clear() pass without the driver sleeping.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include <coroutine>
+#include <hardware/i2c.h>
+#include <LCD_Async.hpp>
+#include "host.hpp"
+
+// Resumes coroutines in time order on the simulated clock
+struct Executor {
+    struct Waiting {
+        std::coroutine_handle<> handle;
+        uint64_t time;
+    };
+    std::vector<Waiting> waiting;
+    int suspends = 0;
+    uint64_t waited = 0;            // time spent waiting for the display
+
+    uint64_t now() { return host_time; }
+    void resumeAt(std::coroutine_handle<> h, uint64_t time)
+    {
+        waiting.push_back({h, time});
+        suspends++;
+    }
+
+    void run()
+    {
+        while(!waiting.empty()) {
+            size_t next = 0;
+            for(size_t i = 1; i < waiting.size(); i++)
+                if(waiting[i].time < waiting[next].time) next = i;
+            Waiting w = waiting[next];
+            waiting.erase(waiting.begin() + next);
+            if(w.time > host_time) {
+                waited += w.time - host_time;
+                host_time = w.time;
+            }
+            w.handle.resume();
+        }
+    }
+};
+
+// A coroutine which starts at once, for the test itself
+struct Job {
+    struct promise_type {
+        Job get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept {}
+    };
+};
+
+static Executor executor;
+static bool finished = false;
+
+static Job display_task(LCD_I2C &lcd, LCD_Model &model)
+{
+    LCD_Async<Executor> async(lcd, executor);
+
+    // Initialization waits through the executor, over 40 ms in all
+    co_await async.init();
+    CHECK(executor.waited >= 40000);
+    lcd.setCursor(0, 0, true);
+    lcd.writeString("Hello from a task", true);
+    co_await async.flush();
+    CHECK(lcd.backlog() == 0);
+    CHECK(model.line(0).compare(0, 17, "Hello from a task") == 0);
+
+    // clear() waits for the display, not in the driver
+    uint64_t waited = executor.waited;
+    co_await async.clear();
+    CHECK(executor.waited - waited >= LCD_I2C::CLEAR_TIME_US);
+    CHECK(model.line(0) == std::string(20, ' '));
+
+    // A long flush is sent in pieces, with other coroutines run between them
+    int suspends = executor.suspends;
+    for(int row = 0; row < 4; row++) {
+        lcd.setCursor(row, 0, true);
+        lcd.writeString("twenty characters!!!", true);
+    }
+    size_t backlog = lcd.backlog();         // what did not already go as the buffer filled
+    CHECK(backlog > 32);
+    co_await async.flush(16);
+    CHECK(lcd.backlog() == 0);
+    CHECK(executor.suspends - suspends >= (int) (backlog / 16 - 1));
+    for(int row = 0; row < 4; row++) CHECK(model.line(row) == "twenty characters!!!");
+    finished = true;
+}
+
+int main()
+{
+    LCD_I2C lcd(0x27, 20, 4, i2c0, false);
+    LCD_Model &model = host_display(0x27);
+    uint64_t start = host_time;
+    display_task(lcd, model);
+    executor.run();
+    CHECK(finished);
+    CHECK(host_time - start >= executor.waited);
+    return host_result();
+}
@@ -0,0 +1,74 @@
+/*
+ * Test of auto flush (write-behind). The flush runs in the alarm interrupt, so it must
+ * never sleep: not to wait out a slow command, and not to recover a lost display.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <hardware/i2c.h>
+#include <LCD_I2C.hpp>
+#include "host.hpp"
+
+static constexpr uint32_t IDLE_US = 1000;
+
+int main()
+{
+    LCD_I2C lcd(0x27, 20, 4);
+    LCD_Model &model = host_display(0x27);
+    lcd.setAutoFlush(IDLE_US);
+
+    // Buffered text goes out once the display has been idle
+    lcd.setCursor(0, 0, true);
+    lcd.writeString("write-behind", true);
+    CHECK(lcd.backlog() > 0);
+    host_run_alarms();
+    CHECK(lcd.backlog() > 0);                   // not idle yet
+    host_time += IDLE_US;
+    host_run_alarms();
+    CHECK(lcd.backlog() == 0);
+    CHECK(model.line(0).compare(0, 12, "write-behind") == 0);
+
+    // A slow command left over from cooperative mode is waited out by trying again
+    lcd.setCooperative(true);
+    lcd.startClear();
+    while(lcd.backlog()) lcd.poll();
+    lcd.setCooperative(false);
+    lcd.setCursor(1, 0, true);
+    lcd.writeString("after clear", true);
+    host_time += IDLE_US;
+    host_run_alarms();
+    CHECK(lcd.backlog() > 0);                   // still clearing
+    host_time += LCD_I2C::CLEAR_TIME_US;
+    host_run_alarms();
+    CHECK(lcd.backlog() == 0);
+    CHECK(model.line(1).compare(0, 11, "after clear") == 0);
+
+    // A display lost in the alarm is only marked lost, however long it is gone
+    host_nak = true;
+    lcd.setCursor(2, 0, true);
+    lcd.writeString("while lost", true);
+    host_time += IDLE_US;
+    host_run_alarms();
+    CHECK(!lcd.connected());
+    host_nak = false;
+    for(int i = 0; i < 5; i++) {
+        host_time += 100000;                    // past the time to look for it
+        lcd.setCursor(3, 0, true);
+        lcd.writeString("still lost", true);
+        host_time += IDLE_US;
+        host_run_alarms();
+    }
+    CHECK(!lcd.connected());
+    CHECK(lcd.recoveries() == 0);
+
+    // And it is recovered by the next call which is not in the alarm
+    lcd.show();
+    CHECK(lcd.connected());
+    CHECK(lcd.recoveries() == 1);
+    CHECK(model.line(0) == std::string(20, ' '));   // cleared before it was lost
+    CHECK(model.line(1).compare(0, 11, "after clear") == 0);
+    CHECK(model.line(2).compare(0, 10, "while lost") == 0);
+    CHECK(model.line(3).compare(0, 10, "still lost") == 0);
+
+    CHECK(host_alarm_sleeps == 0);
+    return host_result();
+}
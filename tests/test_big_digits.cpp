@@ -0,0 +1,44 @@
+/*
+ * Test of the limits of LCD_BigDigits: a readout with no room, and a font taller than the display.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <hardware/i2c.h>
+#include <LCD_BigDigits.hpp>
+#include "host.hpp"
+
+int main()
+{
+    // A two line display
+    LCD_I2C small(0x26, 16, 2);
+    LCD_Model &model = host_display(0x26);
+    model.rows = 2;
+    model.columns = 16;
+    const std::string blank(16, ' ');
+
+    // FONT_3x4 is too tall, so nothing is drawn, not even on the last line
+    LCD_BigDigits tall(small, 0, 0, 4, LCD_BigDigits::FONT_3x4);
+    tall.setNumber(1234);
+    tall.setText("56");
+    CHECK(model.line(0) == blank && model.line(1) == blank);
+
+    // A readout which is given no room draws nothing either
+    LCD_BigDigits none(small, 0, 16, 3, LCD_BigDigits::FONT_3x2);
+    none.setNumber(-7);
+    CHECK(model.line(0) == blank && model.line(1) == blank);
+
+    // But a font which fits is drawn
+    LCD_BigDigits::loadGlyphs(small, LCD_BigDigits::FONT_3x2);
+    LCD_BigDigits fits(small, 0, 0, 4, LCD_BigDigits::FONT_3x2);
+    fits.setNumber(1234);
+    CHECK(model.line(0) != blank && model.line(1) != blank);
+
+    // And the same tall font fits a four line display
+    LCD_I2C large(0x27, 20, 4);
+    LCD_Model &four = host_display(0x27);
+    LCD_BigDigits::loadGlyphs(large, LCD_BigDigits::FONT_3x4);
+    LCD_BigDigits big(large, 0, 0, 4, LCD_BigDigits::FONT_3x4);
+    big.setNumber(1234);
+    for(int row = 0; row < 4; row++) CHECK(four.line(row) != std::string(20, ' '));
+    return host_result();
+}
@@ -0,0 +1,33 @@
+/*
+ * Test of the shared output buffers (LCD_I2C_BUFFER_POOL).
+ */
+#include <stdio.h>
+#include <hardware/i2c.h>
+#include <LCD_BufferPool.hpp>
+#include "host.hpp"
+
+int main()
+{
+    static LCD_BufferPool::byte storage[LCD_I2C::OUTPUT_BUFFER_LENGTH];
+    static LCD_BufferPool pool(storage, sizeof(storage));
+    LCD_I2C::setBufferPool(&pool);
+    CHECK(pool.available() == 1);
+
+    // A display destroyed with output still waiting gives its buffer back
+    {
+        LCD_I2C lcd(0x27, 20, 4);
+        lcd.writeString("never shown", true);
+        CHECK(pool.available() == 0);
+    }
+    CHECK(pool.available() == 1);
+
+    // So the next display can have it
+    LCD_I2C lcd(0x27, 20, 4);
+    lcd.setCursor(1, 0, true);
+    lcd.writeString("pooled", true);
+    CHECK(pool.available() == 0);
+    lcd.show();
+    CHECK(pool.available() == 1);
+    CHECK(host_display(0x27).line(1).compare(0, 6, "pooled") == 0);
+    return host_result();
+}
@@ -0,0 +1,41 @@
+/*
+ * Test that the bus time per byte is measured by show(), not only by poll(),
+ * since clear() uses it to choose between the clear command and writing spaces.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <hardware/i2c.h>
+#include <LCD_I2C.hpp>
+#include "host.hpp"
+
+int main()
+{
+    host_us_per_byte = 23;                      // 400 kHz
+    LCD_I2C lcd(0x27, 20, 4);
+    LCD_Model &model = host_display(0x27);
+
+    // Only blocking calls, which send with show()
+    for(int i = 0; i < 4; i++) {
+        lcd.setCursor(0, 0);
+        lcd.writeString("ten chars!");
+    }
+
+    // At 100 kHz the clear command would be quicker, but at 400 kHz spaces are
+    uint64_t start = host_time;
+    lcd.clear();
+    CHECK(host_time - start < LCD_I2C::CLEAR_TIME_US);
+    CHECK(model.line(0) == std::string(20, ' '));
+
+    // Like the clear command, it leaves the cursor at 0,0, even if it was there before
+    lcd.setCursor(1, 5);
+    lcd.writeString("Hi");
+    lcd.setCursor(0, 0);
+    start = host_time;
+    lcd.clear();
+    CHECK(host_time - start < LCD_I2C::CLEAR_TIME_US);
+    CHECK(model.address == 0 && !model.cgramMode);
+    lcd.writeString("X");
+    CHECK(model.line(0).compare(0, 1, "X") == 0);
+    CHECK(model.line(1) == std::string(20, ' '));
+    return host_result();
+}
@@ -0,0 +1,37 @@
+/*
+ * Test of the C wrapper: lcd_storage_t must hold the display in every configuration.
+ */
+#include <stdio.h>
+#include <LCD_I2C-C.h>
+#include "host.hpp"
+
+int main()
+{
+    // Two displays in caller provided storage
+    static lcd_storage_t storage[2];
+    lcd_handle_t first = lcd_create(&storage[0], 0x27, 20, 4, i2c0);
+    lcd_handle_t second = lcd_create(&storage[1], 0x26, 20, 4, i2c0);
+    CHECK(first && second);
+
+    for(int i = 0; i < 2; i++) {            // twice, so the text cache is used if there is one
+        lcdh_setCursor(first, 1, 0, true);
+        lcdh_writeString(first, "first display", true);
+    }
+    lcdh_setCursor(second, 2, 4, true);
+    lcdh_writeString(second, "second", true);
+    CHECK(lcd_backlog(first) > 0);
+    lcd_show(first);
+    lcd_show(second);
+    CHECK(lcd_backlog(first) == 0);
+    CHECK(host_display(0x27).line(1).compare(0, 13, "first display") == 0);
+    CHECK(host_display(0x26).line(2).compare(4, 6, "second") == 0);
+    lcd_destroy(first);
+    lcd_destroy(second);
+
+    // And the simple interface
+    lcd_init(0x25, 20, 4, i2c0);
+    lcd_setCursor(3, 0);
+    lcd_writeString("simple");
+    CHECK(host_display(0x25).line(3).compare(0, 6, "simple") == 0);
+    return host_result();
+}
@@ -0,0 +1,80 @@
+/*
+ * Test of encoded text (encode(), writeEncoded(), LCD_Screen) when it is larger than the
+ * free space in the output buffer, which must be filled without splitting a character.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <hardware/i2c.h>
+#include <LCD_Screen.hpp>
+#if LCD_I2C_BUFFER_POOL
+#include <LCD_BufferPool.hpp>
+#endif
+#include "host.hpp"
+
+static constexpr LCD_Screen<4, 20> SCREEN({
+    "Temp: _____ C Fan on",
+    "Hum:  ____ % Door ok",
+    "Pump A off  Pump B x",
+    "Menu Back Next Up Dn"});
+
+static constexpr auto LONG_TEXT = LCD_I2C::encode("This text is a good deal longer than a buffer");
+
+static void paint(LCD_I2C &lcd)
+{
+    LCD_Model &model = host_display(0x27);
+    SCREEN.paint(lcd);
+    CHECK(model.line(0) == "Temp:       C Fan on");
+    CHECK(model.line(3) == "Menu Back Next Up Dn");
+    SCREEN.writeField(lcd, 0, "21.5");
+    SCREEN.writeField(lcd, 1, "45");
+    CHECK(model.line(0) == "Temp: 21.5  C Fan on");
+    CHECK(model.line(1) == "Hum:  45   % Door ok");
+
+    lcd.setCursor(2, 0, true);
+    lcd.writeEncoded(LONG_TEXT);
+    CHECK(model.line(2) == "This text is a good ");
+
+    for(int i = 0; i < 2; i++) {        // the second time from the text cache, if there is one
+        lcd.setCursor(2, 0, true);
+        lcd.writeString("Pump A on", true);
+    }
+    lcd.show();
+    CHECK(model.line(2) == "Pump A on is a good ");
+}
+
+int main()
+{
+    CHECK(SCREEN.size() > LCD_I2C::OUTPUT_BUFFER_LENGTH);
+
+    // (With LCD_I2C_BUFFER_POOL and no pool yet, this has only its 5 byte spare buffer)
+    LCD_I2C lcd(0x27, 20, 4);
+    paint(lcd);
+
+    // Partly full to begin with, so the chunks fall at other places
+    for(size_t used = 1; used < 9; used++) {
+        host_reset();
+        LCD_I2C other(0x27, 20, 4);
+        for(size_t i = 0; i < used; i++) other.scrollDisplayLeft(true);
+        for(size_t i = 0; i < used; i++) other.scrollDisplayRight(true);
+        paint(other);
+    }
+
+    // Cooperative, where only poll() sends
+    host_reset();
+    LCD_I2C polled(0x27, 20, 4);
+    polled.setCooperative(true);
+    SCREEN.paint(polled);
+    while(polled.backlog()) polled.poll();
+    CHECK(host_display(0x27).line(3) == "Menu Back Next Up Dn");
+
+    #if LCD_I2C_BUFFER_POOL
+    // And with a buffer from the pool
+    static LCD_BufferPool::byte storage[LCD_I2C::OUTPUT_BUFFER_LENGTH];
+    static LCD_BufferPool pool(storage, sizeof(storage));
+    LCD_I2C::setBufferPool(&pool);
+    host_reset();
+    LCD_I2C pooled(0x27, 20, 4);
+    paint(pooled);
+    #endif
+    return host_result();
+}
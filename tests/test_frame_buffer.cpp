@@ -0,0 +1,62 @@
+/*
+ * Test of LCD_FrameBuffer and its frame limiter, with the writes and frame() on one thread.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <hardware/i2c.h>
+#include <LCD_FrameBuffer.hpp>
+#include "host.hpp"
+
+int main()
+{
+    LCD_I2C lcd(0x27, 20, 4);
+    LCD_Model &model = host_display(0x27);
+    LCD_FrameBuffer fb(lcd);
+    fb.setFrameRate(10);                        // a frame every 100 ms, longer than any frame takes
+
+    // Writes to different cells of a line are all sent, and none is dropped
+    fb.write(0, 0, "AB");
+    fb.write(0, 5, "CD");
+    fb.writeChar(0, 9, 'E');
+    fb.frame();
+    CHECK(fb.frames() == 1);
+    CHECK(fb.dropped() == 0);
+    CHECK(model.line(0).compare(0, 10, "AB   CD  E") == 0);
+
+    // A write over a cell not yet sent replaces the earlier one
+    fb.write(1, 0, "first");
+    fb.write(1, 0, "second");
+    fb.write(1, 10, "other");
+    CHECK(fb.dropped() == 1);
+    CHECK(fb.frame() == 0);                     // not time for the next frame yet
+    CHECK(fb.frames() == 1);
+    CHECK(model.line(1).compare(0, 6, "      ") == 0);
+    host_time += 100000;
+    fb.frame();
+    CHECK(fb.frames() == 2);
+    CHECK(model.line(1).compare(0, 15, "second    other") == 0);
+
+    // Once sent, writing the same cells again is not a drop
+    fb.write(1, 0, "third ");
+    CHECK(fb.dropped() == 1);
+
+    // With a byte limit, the lines which do not fit go in the frames after
+    fb.setFrameRate(10, 100);
+    for(int row = 0; row < 4; row++) fb.write(row, 0, "01234567890123456789");
+    CHECK(fb.dropped() == 2);                   // "third " had not been sent
+    const std::string full = "01234567890123456789";
+    auto shown = [&]() {
+        for(int row = 0; row < 4; row++) if(model.line(row) != full) return false;
+        return true;
+    };
+    int frames = 0;
+    while(!shown() && frames < 10) {
+        host_time += 100000;
+        fb.frame();
+        frames++;
+    }
+    CHECK(frames > 1);
+    CHECK(shown());
+    CHECK(fb.frames() == 2u + frames);
+    return host_result();
+}
@@ -0,0 +1,90 @@
+/*
+ * Stress test of the locking policies (LCD_I2C_LOCKING) and of the reentrant hot path.
+ *
+ * Two threads stand in for the two cores. With a locking policy, both write to one display
+ * and neither may ever interleave its bytes with the other's. Without one, each writes to
+ * its own display on its own bus, which needs nothing shared between displays.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+#include <hardware/i2c.h>
+#include <hardware/sync.h>
+#include <LCD_I2C.hpp>
+#include "host.hpp"
+
+static constexpr int ROUNDS = 20000;
+
+static void label(char text[21], uint core, int n)
+{
+    snprintf(text, 21, "core %u n=%05d", core, n);
+}
+
+#if LCD_I2C_LOCKING != LCD_I2C_LOCK_NONE
+// Both cores share one display. Each keeps two lines together with a Guard.
+static void shared_display(void)
+{
+    LCD_I2C lcd(0x27, 20, 4);
+    auto producer = [&lcd](uint core) {
+        host_core = core;
+        char text[21];
+        for(int n = 0; n < ROUNDS; n++) {
+            label(text, core, n);
+            LCD_I2C::Guard guard(lcd);
+            lcd.setCursor(core, 0, true);
+            lcd.writeString(text, true);
+            lcd.setCursor(core + 2, 0, true);
+            lcd.writeString(text);
+        }
+    };
+    std::thread core0(producer, 0), core1(producer, 1);
+    core0.join();
+    core1.join();
+
+    LCD_Model &model = host_display(0x27);
+    CHECK(host_collisions == 0);
+    for(int row = 0; row < 4; row++) {
+        char text[21];
+        label(text, row % 2, ROUNDS - 1);
+        CHECK(model.line(row).compare(0, strlen(text), text) == 0);
+    }
+}
+#endif
+
+// Each core has a display of its own
+static void separate_displays(void)
+{
+    auto producer = [](uint core) {
+        host_core = core;
+        LCD_I2C lcd(0x27, 20, 4, core ? i2c1 : i2c0);
+        char text[21];
+        for(int n = 0; n < ROUNDS; n++) {
+            label(text, core, n);
+            lcd.setCursor(n % 4, 0, true);
+            lcd.writeString(text);
+        }
+    };
+    std::thread core0(producer, 0), core1(producer, 1);
+    core0.join();
+    core1.join();
+
+    CHECK(host_collisions == 0);
+    for(uint core = 0; core < 2; core++) {
+        LCD_Model &model = host_display(0x27, core ? i2c1 : i2c0);
+        for(int row = 0; row < 4; row++) {
+            char text[21];
+            label(text, core, ROUNDS - 4 + row);
+            CHECK(model.line(row).compare(0, strlen(text), text) == 0);
+        }
+    }
+}
+
+int main()
+{
+    #if LCD_I2C_LOCKING != LCD_I2C_LOCK_NONE
+    shared_display();
+    host_reset();
+    #endif
+    separate_displays();
+    return host_result();
+}
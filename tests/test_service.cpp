@@ -0,0 +1,63 @@
+/*
+ * Test of LCD_Service, the command queue for driving the display from the other core.
+ * Here the producer and the consumer take turns on one thread.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <hardware/i2c.h>
+#include <LCD_Service.hpp>
+#include "host.hpp"
+
+int main()
+{
+    LCD_I2C lcd(0x27, 20, 4);
+    LCD_Model &model = host_display(0x27);
+
+    // Commands which run across the end of the ring, again and again
+    static LCD_Service::byte queue[64];
+    LCD_Service service(lcd, queue, sizeof(queue));
+    CHECK(service.capacity() == 64);
+    char text[21];
+    for(int i = 0; i < 100; i++) {
+        snprintf(text, sizeof(text), "round %03d line %d", i, i % 4);
+        CHECK(service.setCursor(i % 4, 0));
+        CHECK(service.writeString(text));
+        if(i % 3 == 2) while(service.depth()) service.service();   // let a few pile up
+    }
+    while(service.depth()) service.service();
+    for(int row = 0; row < 4; row++) {
+        snprintf(text, sizeof(text), "round %03d line %d", 96 + row, row);
+        CHECK(model.line(row).compare(0, strlen(text), text) == 0);
+    }
+    CHECK(service.dropped() == 0);
+
+    // Fill it up. The command which does not fit is dropped whole.
+    service.resetStatistics();
+    CHECK(service.setCursor(0, 0));
+    while(service.writeString("fill")) {}
+    CHECK(service.dropped() == 1);
+    CHECK(service.highWater() <= service.capacity());
+    CHECK(service.capacity() - service.depth() < 6);
+    while(service.depth()) service.service();
+    CHECK(model.line(0).compare(0, 20, "fillfillfillfillfill") == 0);
+
+    // Storage smaller than 16 bytes is not overrun
+    static LCD_Service::byte small[16];
+    memset(small, 0xAA, sizeof(small));
+    LCD_Service tiny(lcd, small, 10);
+    CHECK(tiny.capacity() == 8);
+    CHECK(!tiny.writeString("too long to fit"));
+    for(int i = 0; i < 20; i++) {
+        if(!tiny.writeString("ab")) tiny.service();
+    }
+    for(size_t i = 8; i < sizeof(small); i++) CHECK(small[i] == 0xAA);
+    tiny.service();
+
+    // And with no storage, everything is dropped
+    LCD_Service none(lcd, nullptr, 0);
+    CHECK(none.capacity() == 0);
+    CHECK(!none.clear());
+    CHECK(none.dropped() == 1);
+    CHECK(none.service() == 0);
+    return host_result();
+}
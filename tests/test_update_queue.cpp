@@ -0,0 +1,85 @@
+/*
+ * Stress test of LCD_UpdateQueue with many producers.
+ *
+ * Each producer thread owns a field and posts to it as fast as it can, while one consumer
+ * thread services the queue. Every text posted is a number written twice, so a field the
+ * consumer caught part way through a post would show two different numbers.
+ *
+ * Each field has exactly one producer. Sharing a field between producers is not supported
+ * (see LCD_UpdateQueue), so it is not tested here: two posts at once could tear the text.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+#include <atomic>
+#include <hardware/i2c.h>
+#include <LCD_UpdateQueue.hpp>
+#include "host.hpp"
+
+static constexpr int PRODUCERS = 8;
+static constexpr int POSTS = 200000;
+static constexpr int WIDTH = 9;
+
+static void text(char out[WIDTH + 1], unsigned n)
+{
+    snprintf(out, WIDTH + 1, "%04u %04u", n % 10000, n % 10000);
+}
+
+// A field shows one whole post, or nothing yet
+static bool whole(const std::string &shown)
+{
+    return shown == std::string(WIDTH, ' ') || (shown.compare(0, 4, shown, 5, 4) == 0 && shown[4] == ' ');
+}
+
+int main()
+{
+    LCD_I2C lcd(0x27, 20, 4);
+    LCD_UpdateQueue queue(lcd);
+    static LCD_UpdateQueue::byte storage[PRODUCERS][2 * WIDTH];
+    LCD_UpdateQueue::Field *fields[PRODUCERS];
+    for(int k = 0; k < PRODUCERS; k++) {
+        fields[k] = new LCD_UpdateQueue::Field(k / 2, (k % 2) * (WIDTH + 1), WIDTH, storage[k], k % 3);
+        queue.attach(*fields[k]);
+    }
+
+    std::atomic<int> running {PRODUCERS};
+    std::atomic<long> torn {0};
+    LCD_Model &model = host_display(0x27);
+
+    std::thread consumer([&]() {
+        bool more = true;
+        while(more) {
+            more = running > 0;             // one last pass after the producers stop
+            queue.service();
+            for(int k = 0; k < PRODUCERS; k++)
+                if(!whole(model.line(k / 2).substr((k % 2) * (WIDTH + 1), WIDTH))) torn++;
+        }
+    });
+    std::thread producers[PRODUCERS];
+    for(int k = 0; k < PRODUCERS; k++) {
+        producers[k] = std::thread([&, k]() {
+            char t[WIDTH + 1];
+            for(int n = 1; n <= POSTS; n++) {
+                text(t, n + k);
+                fields[k]->post(t);
+            }
+            running--;
+        });
+    }
+    for(std::thread &p : producers) p.join();
+    consumer.join();
+
+    CHECK(torn == 0);
+    CHECK(!queue.pending());
+    CHECK(queue.updates() < (uint32_t) PRODUCERS * POSTS);      // posts were coalesced
+    for(int k = 0; k < PRODUCERS; k++) {
+        char t[WIDTH + 1];
+        text(t, POSTS + k);
+        CHECK(fields[k]->posts() == POSTS);
+        if(!CHECK(model.line(k / 2).substr((k % 2) * (WIDTH + 1), WIDTH) == t))
+            printf("field %d shows \"%s\", not \"%s\"\n", k, model.line(k / 2).substr((k % 2) * (WIDTH + 1), WIDTH).c_str(), t);
+        delete fields[k];
+    }
+    printf("%u updates for %d posts, %u retries\n", queue.updates(), PRODUCERS * POSTS, queue.retries());
+    return host_result();
+}